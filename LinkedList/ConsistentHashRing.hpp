@@ -0,0 +1,307 @@
+// file: ConsistentHashRing.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "CircularLinkedList.hpp"
+
+// Consistent hashing over a ring of virtual nodes. Every member is placed on
+// the 64-bit hash circle at `replicas` points; a key belongs to the member of
+// the first point at or after the key's hash, wrapping past the top.
+//
+// The virtual nodes are kept in point order in a CircularLinkedList, so ring()
+// can still be walked and turned with advance() as before. Lookups don't walk
+// it: a sorted side index of the points answers owner() with one binary search,
+// O(log n) in the number of virtual nodes.
+//
+// add() and remove() change the ring incrementally, O(n + replicas), and
+// return the ranges of the circle that changed owner. A range is (low, high];
+// low > high means it wraps past the top of the circle. Adjacent ranges with
+// the same old and new owner are reported as one.
+template<class Member, class Hash = std::hash<Member>>
+class ConsistentHashRing {
+    public:
+        struct vnode {
+            uint64_t point;
+            Member owner;
+            bool operator<(const vnode& other) const { return point < other.point; };
+        };
+
+        struct remap {
+            uint64_t low;                                 // exclusive
+            uint64_t high;                                // inclusive
+            Member from;
+            Member to;
+        };
+
+    private:
+        CircularLinkedList<vnode> ring_;                  // virtual nodes in point order
+        std::vector<uint64_t> points_;                    // sorted side index over the ring
+        std::vector<Member> owners_;                      // owner of points_[i]
+        std::vector<std::pair<Member, size_t>> members_;  // member and its number of virtual nodes
+        size_t replicas_;                                 // virtual nodes per member for add(member)
+
+        static uint64_t mix(uint64_t);
+        size_t at_or_after(uint64_t) const;               // side index position owning the point
+        size_t member_index(const Member&) const;         // position in members_, members_.size() if absent
+        static void push_remap(std::vector<remap>&, uint64_t, uint64_t, const Member&, const Member&);
+
+    public:
+        explicit ConsistentHashRing(size_t replicas = 100);
+
+        std::vector<remap> add(const Member&);            // add with the default number of virtual nodes
+        std::vector<remap> add(const Member&, size_t);    // add with that many virtual nodes, a weight
+        std::vector<remap> remove(const Member&);         // take every virtual node of the member off the ring
+
+        template<class Key>
+        static uint64_t point_of(const Key&);             // where the key lands on the circle
+        template<class Key>
+        const Member& owner(const Key&) const;            // member the key belongs to, O(log n)
+        const Member& owner_of_point(uint64_t) const;     // member owning that point of the circle
+        template<class Key>
+        std::vector<Member> owners(const Key&, size_t) const; // up to that many distinct members, clockwise from the key
+
+        bool contains(const Member&) const;               // true if the member is on the ring
+        size_t members() const;                           // number of members
+        size_t size() const;                              // number of virtual nodes
+        bool empty() const;                               // true without members
+        const CircularLinkedList<vnode>& ring() const;    // the virtual nodes in point order
+};
+
+template<class Member, class Hash>
+ConsistentHashRing<Member, Hash>::ConsistentHashRing(size_t replicas) {
+    replicas_ = (replicas == 0) ? 1 : replicas;
+}
+
+template<class Member, class Hash>
+uint64_t ConsistentHashRing<Member, Hash>::mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+template<class Member, class Hash>
+size_t ConsistentHashRing<Member, Hash>::at_or_after(uint64_t point) const {
+    size_t i = size_t(std::lower_bound(points_.begin(), points_.end(), point) - points_.begin());
+    return (i == points_.size()) ? 0 : i;
+}
+
+template<class Member, class Hash>
+size_t ConsistentHashRing<Member, Hash>::member_index(const Member& member) const {
+    size_t i = 0;
+    while (i < members_.size() && !(members_[i].first == member)) {
+        i++;
+    }
+    return i;
+}
+
+template<class Member, class Hash>
+void ConsistentHashRing<Member, Hash>::push_remap(std::vector<remap>& out, uint64_t low, uint64_t high, const Member& from, const Member& to) {
+    if (!out.empty() && out.back().high == low && out.back().from == from && out.back().to == to) {
+        out.back().high = high;
+    } else {
+        out.push_back(remap{low, high, from, to});
+    }
+}
+
+template<class Member, class Hash>
+std::vector<typename ConsistentHashRing<Member, Hash>::remap> ConsistentHashRing<Member, Hash>::add(const Member& member) {
+    return add(member, replicas_);
+}
+
+template<class Member, class Hash>
+std::vector<typename ConsistentHashRing<Member, Hash>::remap> ConsistentHashRing<Member, Hash>::add(const Member& member, size_t replicas) {
+    if (contains(member)) {
+        throw std::invalid_argument("the member is already on the ring");
+    }
+    if (replicas == 0) {
+        replicas = 1;
+    }
+
+    // the points of the new virtual nodes, moved along until none is taken
+    uint64_t seed = mix(uint64_t(Hash()(member)));
+    std::vector<uint64_t> fresh(replicas);
+    for (size_t r = 0; r < replicas; r++) {
+        fresh[r] = mix(seed + 0x9e3779b97f4a7c15ULL * (r + 1));
+    }
+    std::sort(fresh.begin(), fresh.end());
+    for (bool clash = true; clash; ) {
+        clash = false;
+        for (size_t r = 0; r < replicas; r++) {
+            bool taken = std::binary_search(points_.begin(), points_.end(), fresh[r]);
+            if (taken || (r > 0 && fresh[r] == fresh[r - 1])) {
+                fresh[r] = mix(fresh[r] + 1);
+                clash = true;
+            }
+        }
+        if (clash) {
+            std::sort(fresh.begin(), fresh.end());
+        }
+    }
+
+    // merge them into the side index; every new point takes the range from
+    // its predecessor up to itself away from the owner of the next old point
+    size_t total = points_.size() + replicas;
+    std::vector<uint64_t> points;
+    std::vector<Member> owners;
+    std::vector<uint8_t> added;
+    points.reserve(total);
+    owners.reserve(total);
+    added.reserve(total);
+    size_t a = 0;
+    size_t b = 0;
+    while (a < points_.size() || b < replicas) {
+        if (b == replicas || (a < points_.size() && points_[a] < fresh[b])) {
+            points.push_back(points_[a]);
+            owners.push_back(owners_[a]);
+            added.push_back(0);
+            a++;
+        } else {
+            points.push_back(fresh[b]);
+            owners.push_back(member);
+            added.push_back(1);
+            b++;
+        }
+    }
+
+    std::vector<remap> moved;
+    if (!points_.empty()) {
+        for (size_t i = 0; i < total; i++) {
+            if (added[i] != 0) {
+                uint64_t low = points[(i == 0) ? total - 1 : i - 1];
+                push_remap(moved, low, points[i], owners_[at_or_after(points[i])], member);
+            }
+        }
+        if (moved.size() > 1 && added[0] != 0 && added[total - 1] != 0) {
+            moved.front().low = moved.back().low;        // the run across the top of the circle is one range
+            moved.pop_back();
+        }
+    }
+
+    CircularLinkedList<vnode> batch;
+    for (size_t r = 0; r < replicas; r++) {
+        batch.push_back(vnode{fresh[r], member});
+    }
+    ring_.merge(batch);
+    points_.swap(points);
+    owners_.swap(owners);
+    members_.push_back(std::make_pair(member, replicas));
+    return moved;
+}
+
+template<class Member, class Hash>
+std::vector<typename ConsistentHashRing<Member, Hash>::remap> ConsistentHashRing<Member, Hash>::remove(const Member& member) {
+    size_t m = member_index(member);
+    if (m == members_.size()) {
+        throw std::invalid_argument("the member is not on the ring");
+    }
+    members_.erase(members_.begin() + m);
+
+    // every removed point hands the range from its predecessor up to itself
+    // to the owner of the next point that stays
+    size_t total = points_.size();
+    std::vector<uint64_t> points;
+    std::vector<Member> owners;
+    points.reserve(total);
+    owners.reserve(total);
+    for (size_t i = 0; i < total; i++) {
+        if (!(owners_[i] == member)) {
+            points.push_back(points_[i]);
+            owners.push_back(owners_[i]);
+        }
+    }
+
+    std::vector<remap> moved;
+    if (!points.empty()) {
+        size_t next = 0;                                  // first kept point after i, in points
+        for (size_t i = 0; i < total; i++) {
+            if (owners_[i] == member) {
+                uint64_t low = points_[(i == 0) ? total - 1 : i - 1];
+                push_remap(moved, low, points_[i], member, owners[(next == points.size()) ? 0 : next]);
+            } else {
+                next++;
+            }
+        }
+        if (moved.size() > 1 && owners_[0] == member && owners_[total - 1] == member) {
+            moved.front().low = moved.back().low;        // the run across the top of the circle is one range
+            moved.pop_back();
+        }
+    }
+
+    ring_.remove_if([&member](const vnode& v) { return v.owner == member; });
+    points_.swap(points);
+    owners_.swap(owners);
+    return moved;
+}
+
+template<class Member, class Hash>
+template<class Key>
+uint64_t ConsistentHashRing<Member, Hash>::point_of(const Key& key) {
+    return mix(uint64_t(std::hash<Key>()(key)));
+}
+
+template<class Member, class Hash>
+template<class Key>
+const Member& ConsistentHashRing<Member, Hash>::owner(const Key& key) const {
+    return owner_of_point(point_of(key));
+}
+
+template<class Member, class Hash>
+const Member& ConsistentHashRing<Member, Hash>::owner_of_point(uint64_t point) const {
+    if (points_.empty()) {
+        throw std::out_of_range("the ring is empty");
+    }
+    return owners_[at_or_after(point)];
+}
+
+template<class Member, class Hash>
+template<class Key>
+std::vector<Member> ConsistentHashRing<Member, Hash>::owners(const Key& key, size_t count) const {
+    std::vector<Member> result;
+    if (points_.empty()) {
+        return result;
+    }
+    size_t want = std::min(count, members_.size());
+    size_t i = at_or_after(point_of(key));
+    for (size_t steps = 0; steps < points_.size() && result.size() < want; steps++) {
+        if (std::find(result.begin(), result.end(), owners_[i]) == result.end()) {
+            result.push_back(owners_[i]);
+        }
+        i = (i + 1 == points_.size()) ? 0 : i + 1;
+    }
+    return result;
+}
+
+template<class Member, class Hash>
+bool ConsistentHashRing<Member, Hash>::contains(const Member& member) const {
+    return member_index(member) != members_.size();
+}
+
+template<class Member, class Hash>
+size_t ConsistentHashRing<Member, Hash>::members() const {
+    return members_.size();
+}
+
+template<class Member, class Hash>
+size_t ConsistentHashRing<Member, Hash>::size() const {
+    return points_.size();
+}
+
+template<class Member, class Hash>
+bool ConsistentHashRing<Member, Hash>::empty() const {
+    return members_.empty();
+}
+
+template<class Member, class Hash>
+const CircularLinkedList<typename ConsistentHashRing<Member, Hash>::vnode>& ConsistentHashRing<Member, Hash>::ring() const {
+    return ring_;
+}
@@ -0,0 +1,168 @@
+// file: CountingBloomFilter.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Counting Bloom filter with 4-bit counters, used as the membership summary
+// of SinglyLinkedList / DoublyLinkedList. possibly_contains() never reports a
+// false negative for values inserted and not erased; a false positive happens
+// with about the configured rate while at most `expected` values are stored.
+// Counters saturate at 15 and then stay there, so erase() never underflows.
+// Sized for expected values and fp_rate it takes about
+// -expected * ln(fp_rate) / ln(2)^2 / 2 bytes, e.g. 4.8 bytes per value at 1%;
+// max_bytes caps that at the price of a higher false positive rate.
+template<class T, class Hash = std::hash<T>>
+class CountingBloomFilter;
+
+// true if Hash can hash a T; the lists only keep a summary for those, so a
+// list of a type without std::hash still compiles as long as it never calls
+// enable_summary()
+template<class T, class Hash = std::hash<T>, class = void>
+struct is_summarizable : std::false_type {};
+template<class T, class Hash>
+struct is_summarizable<T, Hash, std::void_t<decltype(size_t(std::declval<const Hash&>()(std::declval<const T&>())))>> : std::true_type {};
+
+template<class T, class Hash>
+class CountingBloomFilter {
+    private:
+        static const size_t counters_per_word = 16;
+
+        std::vector<uint64_t> words_;
+        size_t counters_;                                 // number of 4-bit counters
+        size_t hashes_;                                   // counters touched per value
+        size_t expected_;
+        double fp_rate_;
+        size_t max_bytes_;
+
+        static uint64_t mix(uint64_t);
+        void probes(const T&, uint64_t&, uint64_t&) const; // the two hashes combined into the probe sequence
+        uint32_t get(size_t) const;
+        void set(size_t, uint32_t);
+
+    public:
+        CountingBloomFilter(size_t expected, double fp_rate = 0.01, size_t max_bytes = 0);
+
+        void insert(const T&);                            // count one more copy of the value
+        void erase(const T&);                             // count one copy less, the value must have been inserted
+        bool possibly_contains(const T&) const;           // false means the value is definitely absent
+        void clear();                                     // forget every value
+        void reserve(size_t);                             // clear and resize for that many values, same rate and cap
+
+        size_t expected() const;                          // number of values the filter was sized for
+        size_t bytes() const;                             // bytes held by the counters
+};
+
+template<class T, class Hash>
+CountingBloomFilter<T, Hash>::CountingBloomFilter(size_t expected, double fp_rate, size_t max_bytes) {
+    fp_rate_ = (fp_rate > 0.0 && fp_rate < 1.0) ? fp_rate : 0.01;
+    max_bytes_ = max_bytes;
+    reserve(expected);
+}
+
+template<class T, class Hash>
+uint64_t CountingBloomFilter<T, Hash>::mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+template<class T, class Hash>
+void CountingBloomFilter<T, Hash>::probes(const T& val, uint64_t& h1, uint64_t& h2) const {
+    h1 = mix(uint64_t(Hash()(val)));
+    h2 = mix(h1 ^ 0x9e3779b97f4a7c15ULL) | 1;
+}
+
+template<class T, class Hash>
+uint32_t CountingBloomFilter<T, Hash>::get(size_t i) const {
+    return uint32_t(words_[i / counters_per_word] >> (4 * (i % counters_per_word))) & 0xf;
+}
+
+template<class T, class Hash>
+void CountingBloomFilter<T, Hash>::set(size_t i, uint32_t count) {
+    uint64_t& word = words_[i / counters_per_word];
+    unsigned shift = 4 * (i % counters_per_word);
+    word = (word & ~(uint64_t(0xf) << shift)) | (uint64_t(count) << shift);
+}
+
+template<class T, class Hash>
+void CountingBloomFilter<T, Hash>::insert(const T& val) {
+    uint64_t h1, h2;
+    probes(val, h1, h2);
+    for (size_t i = 0; i < hashes_; i++) {
+        size_t c = size_t((h1 + i * h2) % counters_);
+        uint32_t count = get(c);
+        if (count != 0xf) {
+            set(c, count + 1);
+        }
+    }
+}
+
+template<class T, class Hash>
+void CountingBloomFilter<T, Hash>::erase(const T& val) {
+    uint64_t h1, h2;
+    probes(val, h1, h2);
+    for (size_t i = 0; i < hashes_; i++) {
+        size_t c = size_t((h1 + i * h2) % counters_);
+        uint32_t count = get(c);
+        if (count != 0 && count != 0xf) {
+            set(c, count - 1);
+        }
+    }
+}
+
+template<class T, class Hash>
+bool CountingBloomFilter<T, Hash>::possibly_contains(const T& val) const {
+    uint64_t h1, h2;
+    probes(val, h1, h2);
+    for (size_t i = 0; i < hashes_; i++) {
+        if (get(size_t((h1 + i * h2) % counters_)) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<class T, class Hash>
+void CountingBloomFilter<T, Hash>::clear() {
+    std::fill(words_.begin(), words_.end(), 0);
+}
+
+template<class T, class Hash>
+void CountingBloomFilter<T, Hash>::reserve(size_t expected) {
+    if (expected == 0) {
+        expected = 1;
+    }
+    const double ln2 = std::log(2.0);
+    double m = std::ceil(-double(expected) * std::log(fp_rate_) / (ln2 * ln2));
+    if (max_bytes_ != 0 && m > double(max_bytes_) * 2) {
+        m = double(max_bytes_) * 2;
+    }
+    size_t words = (size_t(m) + counters_per_word - 1) / counters_per_word;
+    words_.assign((words == 0) ? 1 : words, 0);
+    words_.shrink_to_fit();
+    counters_ = words_.size() * counters_per_word;
+    size_t k = size_t(std::lround(double(counters_) / double(expected) * ln2));
+    hashes_ = (k < 1) ? 1 : (k > 16) ? 16 : k;
+    expected_ = expected;
+}
+
+template<class T, class Hash>
+size_t CountingBloomFilter<T, Hash>::expected() const {
+    return expected_;
+}
+
+template<class T, class Hash>
+size_t CountingBloomFilter<T, Hash>::bytes() const {
+    return words_.capacity() * sizeof(uint64_t);
+}
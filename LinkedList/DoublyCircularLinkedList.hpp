@@ -0,0 +1,495 @@
+// file: DoublyCircularLinkedList.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "ElementWriter.hpp"
+#include "KeySearch.hpp"
+#include "NodeAllocator.hpp"
+
+// Doubly linked ring with a sentinel, for CircularLinkedList users that pop
+// the back or step the cursor backward.
+// The sentinel sits between the back (the cursor) and the front, so an empty
+// ring is just the sentinel linked to itself and no operation needs a nullptr
+// special case. pop_back(), advance(), retreat() and erase(iterator) are O(1);
+// remove(index) walks from the nearer end.
+//
+// It is not built on list_core and only has part of the CircularLinkedList
+// API: construction, move and swap, front / back, begin / end, push_front,
+// push_back, pop_front, pop_back, find() const, find_many, insert and remove
+// by index, remove_value, remove_if and erase_if, advance, size, empty,
+// write_to and print. Code written against that subset switches over by
+// changing the type. The policies (Organize, Size, Instrument, Checkpoint,
+// Alloc) and the reordering find(), extract() and the node_type pushes,
+// apply_batch, reverse, merge and the set_* operations, enable_summary(),
+// segments() and so ParallelList, set_reclaim_mode / reclaim and stats() are
+// CircularLinkedList only. retreat(), erase() and print_reverse() are the
+// additions.
+
+template<class T> class DoublyCircularLinkedList;
+
+template<class T>
+class DoublyCircularLink {
+    private:
+        DoublyCircularLink<T>* prev;
+        DoublyCircularLink<T>* next;
+    public:
+        DoublyCircularLink() : prev(this), next(this) {};
+        DoublyCircularLink(DoublyCircularLink<T>* p, DoublyCircularLink<T>* n) : prev(p), next(n) {};
+        friend class DoublyCircularLinkedList<T>;
+};
+
+template<class T>
+class DoublyCircularNode : public DoublyCircularLink<T> {
+    private:
+        T val;
+    public:
+        DoublyCircularNode(const T& _val, DoublyCircularLink<T>* p, DoublyCircularLink<T>* n)
+            : DoublyCircularLink<T>(p, n), val(_val) {};
+        static void* operator new(size_t size) { return node_allocator<DoublyCircularNode<T>>::allocate(size); };
+        static void operator delete(void* p, size_t size) { node_allocator<DoublyCircularNode<T>>::deallocate(p, size); };
+        friend class DoublyCircularLinkedList<T>;
+};
+
+template<class T>
+class DoublyCircularLinkedList {
+    private:
+        typedef DoublyCircularLink<T> link_type;
+        typedef DoublyCircularNode<T> node_type;
+
+        link_type sentinel_;                              // prev is the back (cursor), next is the front
+        size_t size_;
+
+        static node_type* node(link_type*);
+        link_type* at(size_t) const;                      // link at position, walking from the nearer end
+        void link_before(link_type*, const T&);           // new node in front of the given link
+        void unlink(link_type*);                          // unlink and delete a node
+        void fix_sentinel();                              // point the neighbours back at sentinel_ after a swap
+
+    public:
+        static const size_t npos = -1;
+
+        template<class U>
+        class basic_iterator {                            // bidirectional iterator, U is T or const T
+            private:
+                link_type* link_;
+                template<class> friend class basic_iterator;
+                friend class DoublyCircularLinkedList<T>;
+            public:
+                typedef std::bidirectional_iterator_tag iterator_category;
+                typedef T value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef U* pointer;
+                typedef U& reference;
+
+                basic_iterator() : link_(nullptr) {};
+                explicit basic_iterator(link_type* link) : link_(link) {};
+                basic_iterator(const basic_iterator<T>& other) : link_(other.link_) {};
+
+                reference operator*() const { return static_cast<node_type*>(link_)->val; };
+                pointer operator->() const { return &static_cast<node_type*>(link_)->val; };
+                basic_iterator& operator++() { link_ = link_->next; return *this; };
+                basic_iterator operator++(int) { basic_iterator old = *this; link_ = link_->next; return old; };
+                basic_iterator& operator--() { link_ = link_->prev; return *this; };
+                basic_iterator operator--(int) { basic_iterator old = *this; link_ = link_->prev; return old; };
+                bool operator==(const basic_iterator& other) const { return link_ == other.link_; };
+                bool operator!=(const basic_iterator& other) const { return link_ != other.link_; };
+        };
+        typedef basic_iterator<T> iterator;
+        typedef basic_iterator<const T> const_iterator;
+
+        DoublyCircularLinkedList();                       // constructor
+        ~DoublyCircularLinkedList();                      // destructor
+        DoublyCircularLinkedList(const DoublyCircularLinkedList<T>&) = delete;
+        DoublyCircularLinkedList<T>& operator=(const DoublyCircularLinkedList<T>&) = delete;
+        DoublyCircularLinkedList(DoublyCircularLinkedList<T>&&) noexcept; // move constructor, takes over the nodes in O(1)
+        DoublyCircularLinkedList<T>& operator=(DoublyCircularLinkedList<T>&&) noexcept; // move assignment
+        void swap(DoublyCircularLinkedList<T>&) noexcept; // exchange the contents in O(1)
+
+        T& front();                                       // return head element
+        T& back();                                        // return the element under the cursor
+        void clear();                                     // make the linked List to empty
+
+        iterator begin();                                 // iterator to the front element
+        iterator end();                                   // iterator past the back element
+        const_iterator begin() const;                     // overloading begin()
+        const_iterator end() const;                       // overloading end()
+
+        void push_front(const T&);                        // insert element to front of Linked list
+        void push_front(const T&&);                       // overloading push_front()
+
+        void push_back(const T&);                         // insert element to end of Linked list
+        void push_back(const T&&);                        // overloading push_back()
+
+        void pop_front();                                 // remove the front element in Linked list
+
+        void pop_back();                                  // remove the element under the cursor in O(1)
+
+        size_t find(const T&) const;                      // check the value is exit in the linked list and return the index
+        size_t find(const T&&) const;                     // overloading find()
+        std::vector<size_t> find_many(const T*, size_t) const; // index of each key in one walk, npos when absent
+
+        void insert(const T&, const size_t&);             // insert elements according to the index
+        void insert(const T&, const size_t&&);            // overloading insert()
+        void insert(const T&&, const size_t&);            // overloading insert()
+        void insert(const T&&, const size_t&&);           // overloading insert()
+
+        void remove(const size_t&);                       // remove element by index
+        void remove(const size_t&&);                      // overloading remove()
+        iterator erase(const_iterator);                   // remove the element at the iterator in O(1), return the one after it
+        size_t remove_value(const T&);                    // remove every element equal to the value in one pass, return the count
+        template<class Pred>
+        size_t remove_if(Pred);                           // remove every element matching pred in one pass, return the count
+
+        void advance();                                   // move the cursor forward, the front becomes the back
+        void retreat();                                   // move the cursor backward, the back becomes the front
+
+        size_t size() const;                              // return size of Linked list;
+        bool empty() const;                               // check the Linked list is empty
+        void write_to(ElementWriter&, const char* = " ", const char* = "\n") const; // the elements, the separator between them, then the terminator
+        void write_to(std::ostream&, const char* = " ", const char* = "\n") const; // buffered write to the stream, does not flush it
+        void write_to(int, const char* = " ", const char* = "\n") const; // buffered write to the file descriptor, one write() per buffer
+        void print() const;                               // print the elements from front to back
+        void print_reverse() const;                       // print the elements from back to front
+};
+
+template<class T>
+typename DoublyCircularLinkedList<T>::node_type* DoublyCircularLinkedList<T>::node(link_type* link) {
+    return static_cast<node_type*>(link);
+}
+
+template<class T>
+typename DoublyCircularLinkedList<T>::link_type* DoublyCircularLinkedList<T>::at(size_t index) const {
+    link_type* curr;
+    if (index > size_ / 2) {
+        curr = sentinel_.prev;
+        for (size_t i = 0; i < size_ - index - 1; i++) {
+            curr = curr->prev;
+        }
+    } else {
+        curr = sentinel_.next;
+        for (size_t i = 0; i < index; i++) {
+            curr = curr->next;
+        }
+    }
+    return curr;
+}
+
+template<class T>
+void DoublyCircularLinkedList<T>::link_before(link_type* pos, const T& val) {
+    link_type* insert_node = new node_type(val, pos->prev, pos);
+    pos->prev->next = insert_node;
+    pos->prev = insert_node;
+    size_++;
+}
+
+template<class T>
+void DoublyCircularLinkedList<T>::unlink(link_type* link) {
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    delete node(link);
+    size_--;
+}
+
+template<class T>
+void DoublyCircularLinkedList<T>::fix_sentinel() {
+    if (size_ == 0) {
+        sentinel_.prev = &sentinel_;
+        sentinel_.next = &sentinel_;
+    } else {
+        sentinel_.next->prev = &sentinel_;
+        sentinel_.prev->next = &sentinel_;
+    }
+}
+
+template<class T>
+DoublyCircularLinkedList<T>::DoublyCircularLinkedList() {
+    size_ = 0;
+}
+
+template<class T>
+DoublyCircularLinkedList<T>::~DoublyCircularLinkedList() {
+    clear();
+}
+
+template<class T>
+DoublyCircularLinkedList<T>::DoublyCircularLinkedList(DoublyCircularLinkedList<T>&& other) noexcept {
+    size_ = 0;
+    swap(other);
+}
+
+template<class T>
+DoublyCircularLinkedList<T>& DoublyCircularLinkedList<T>::operator=(DoublyCircularLinkedList<T>&& other) noexcept {
+    if (this != &other) {
+        clear();
+        swap(other);
+    }
+    return *this;
+}
+
+template<class T>
+void DoublyCircularLinkedList<T>::swap(DoublyCircularLinkedList<T>& other) noexcept {
+    std::swap(sentinel_.prev, other.sentinel_.prev);
+    std::swap(sentinel_.next, other.sentinel_.next);
+    std::swap(size_, other.size_);
+    fix_sentinel();
+    other.fix_sentinel();
+}
+
+template<class T>
+void swap(DoublyCircularLinkedList<T>& a, DoublyCircularLinkedList<T>& b) noexcept {
+    a.swap(b);
+}
+
+template<class T>
+T& DoublyCircularLinkedList<T>::front() {
+    return node(sentinel_.next)->val;
+}
+
+template<class T>
+T& DoublyCircularLinkedList<T>::back() {
+    return node(sentinel_.prev)->val;
+}
+
+template<class T>
+void DoublyCircularLinkedList<T>::clear() {
+    link_type* curr = sentinel_.next;
+    while (curr != &sentinel_) {
+        link_type* del_node = curr;
+        curr = curr->next;
+        delete node(del_node);
+    }
+    sentinel_.prev = &sentinel_;
+    sentinel_.next = &sentinel_;
+    size_ = 0;
+}
+
+template<class T>
+typename DoublyCircularLinkedList<T>::iterator DoublyCircularLinkedList<T>::begin() {
+    return iterator(sentinel_.next);
+}
+
+template<class T>
+typename DoublyCircularLinkedList<T>::iterator DoublyCircularLinkedList<T>::end() {
+    return iterator(&sentinel_);
+}
+
+template<class T>
+typename DoublyCircularLinkedList<T>::const_iterator DoublyCircularLinkedList<T>::begin() const {
+    return const_iterator(sentinel_.next);
+}
+
+template<class T>
+typename DoublyCircularLinkedList<T>::const_iterator DoublyCircularLinkedList<T>::end() const {
+    return const_iterator(const_cast<link_type*>(&sentinel_));
+}
+
+template<class T>
+void DoublyCircularLinkedList<T>::push_front(const T& val) {
+    link_before(sentinel_.next, val);
+}
+
+template<class T>
+void DoublyCircularLinkedList<T>::push_front(const T&& val) {
+    link_before(sentinel_.next, val);
+}
+
+template<class T>
+void DoublyCircularLinkedList<T>::push_back(const T& val) {
+    link_before(&sentinel_, val);
+}
+
+template<class T>
+void DoublyCircularLinkedList<T>::push_back(const T&& val) {
+    link_before(&sentinel_, val);
+}
+
+template<class T>
+void DoublyCircularLinkedList<T>::pop_front() {
+    if (size_ != 0) {
+        unlink(sentinel_.next);
+    }
+}
+
+template<class T>
+void DoublyCircularLinkedList<T>::pop_back() {
+    if (size_ != 0) {
+        unlink(sentinel_.prev);
+    }
+}
+
+template<class T>
+size_t DoublyCircularLinkedList<T>::find(const T& val) const {
+    size_t index = 0;
+    for (const link_type* curr = sentinel_.next; curr != &sentinel_; curr = curr->next) {
+        if (static_cast<const node_type*>(curr)->val == val) {
+            return index;
+        }
+        index++;
+    }
+    return npos;
+}
+
+template<class T>
+size_t DoublyCircularLinkedList<T>::find(const T&& val) const {
+    return find(val);
+}
+
+template<class T>
+std::vector<size_t> DoublyCircularLinkedList<T>::find_many(const T* keys, size_t count) const {
+    KeySearch<T> search(keys, count);
+    for (const link_type* curr = sentinel_.next; curr != &sentinel_ && !search.done(); curr = curr->next) {
+        search.add(static_cast<const node_type*>(curr)->val);
+    }
+    return search.positions();
+}
+
+template<class T>
+void DoublyCircularLinkedList<T>::insert(const T& val, const size_t& index) {
+    if (index > size_) {
+        throw std::overflow_error("the index overflow error");
+    }
+    link_before((index == size_) ? &sentinel_ : at(index), val);
+}
+
+template<class T>
+void DoublyCircularLinkedList<T>::insert(const T& val, const size_t&& index) {
+    insert(val, index);
+}
+
+template<class T>
+void DoublyCircularLinkedList<T>::insert(const T&& val, const size_t& index) {
+    insert(val, index);
+}
+
+template<class T>
+void DoublyCircularLinkedList<T>::insert(const T&& val, const size_t&& index) {
+    insert(val, index);
+}
+
+template<class T>
+void DoublyCircularLinkedList<T>::remove(const size_t& index) {
+    if (index >= size_) {
+        throw std::overflow_error("The index is overflow");
+    }
+    unlink(at(index));
+}
+
+template<class T>
+void DoublyCircularLinkedList<T>::remove(const size_t&& index) {
+    remove(index);
+}
+
+template<class T>
+typename DoublyCircularLinkedList<T>::iterator DoublyCircularLinkedList<T>::erase(const_iterator pos) {
+    link_type* link = pos.link_;
+    if (link == &sentinel_) {
+        throw std::overflow_error("The index is overflow");
+    }
+    link_type* next = link->next;
+    unlink(link);
+    return iterator(next);
+}
+
+template<class T>
+size_t DoublyCircularLinkedList<T>::remove_value(const T& val) {
+    return remove_if([&val](const T& x) { return x == val; });
+}
+
+template<class T>
+template<class Pred>
+size_t DoublyCircularLinkedList<T>::remove_if(Pred pred) {
+    size_t count = 0;
+    link_type* curr = sentinel_.next;
+    while (curr != &sentinel_) {
+        link_type* next = curr->next;
+        if (pred(node(curr)->val)) {
+            unlink(curr);
+            count++;
+        }
+        curr = next;
+    }
+    return count;
+}
+
+template<class T, class Pred>
+size_t erase_if(DoublyCircularLinkedList<T>& list, Pred pred) {
+    return list.remove_if(pred);
+}
+
+template<class T>
+void DoublyCircularLinkedList<T>::advance() {
+    if (size_ < 2) {
+        return;
+    }
+    // move the sentinel from in front of the front element to behind it
+    link_type* front = sentinel_.next;
+    sentinel_.prev->next = front;
+    front->prev = sentinel_.prev;
+    sentinel_.prev = front;
+    sentinel_.next = front->next;
+    front->next->prev = &sentinel_;
+    front->next = &sentinel_;
+}
+
+template<class T>
+void DoublyCircularLinkedList<T>::retreat() {
+    if (size_ < 2) {
+        return;
+    }
+    // move the sentinel from behind the back element to in front of it
+    link_type* back = sentinel_.prev;
+    back->next = sentinel_.next;
+    sentinel_.next->prev = back;
+    sentinel_.next = back;
+    sentinel_.prev = back->prev;
+    back->prev->next = &sentinel_;
+    back->prev = &sentinel_;
+}
+
+template<class T>
+size_t DoublyCircularLinkedList<T>::size() const {
+    return size_;
+}
+
+template<class T>
+bool DoublyCircularLinkedList<T>::empty() const {
+    return size_ == 0;
+}
+
+template<class T>
+void DoublyCircularLinkedList<T>::write_to(ElementWriter& out, const char* separator, const char* terminator) const {
+    out.put_range(begin(), end(), separator, terminator);
+}
+
+template<class T>
+void DoublyCircularLinkedList<T>::write_to(std::ostream& stream, const char* separator, const char* terminator) const {
+    ElementWriter out(stream);
+    write_to(out, separator, terminator);
+    out.write_out();                                      // here, not in the destructor, so a failed write throws
+}
+
+template<class T>
+void DoublyCircularLinkedList<T>::write_to(int fd, const char* separator, const char* terminator) const {
+    ElementWriter out(fd);
+    write_to(out, separator, terminator);
+    out.write_out();                                      // here, not in the destructor, so a failed write throws
+}
+
+template<class T>
+void DoublyCircularLinkedList<T>::print() const {
+    write_to(std::cout);
+    std::cout.flush();
+}
+
+template<class T>
+void DoublyCircularLinkedList<T>::print_reverse() const {
+    ElementWriter out(std::cout);
+    out.put_range(std::make_reverse_iterator(end()), std::make_reverse_iterator(begin()), " ", "\n");
+    out.flush();
+}
@@ -0,0 +1,196 @@
+// file: ElementWriter.hpp
+
+#pragma once
+
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unistd.h>
+
+// Buffered output behind the write_to() functions of the lists. Elements are
+// formatted straight into one large buffer: arithmetic values with
+// std::to_chars (floating point in its shortest round-trip form), strings as
+// they are, anything else through operator<<. A full buffer goes out in one
+// piece: one write() call on a file descriptor, one write() on a stream or
+// one append to a string. Nothing is flushed unless flush() is called; the
+// destructor only hands over what is still buffered and drops any error doing
+// so, since it may run while an exception unwinds. Call write_out() or flush()
+// before the writer goes away to see a failed write.
+//
+//     ElementWriter out(fd);
+//     a.write_to(out, ",");
+//     b.write_to(out, ",");
+//     out.flush();
+class ElementWriter {
+    private:
+        std::ostream* stream_;
+        int fd_;
+        std::string* text_;
+        std::unique_ptr<char[]> buffer_;
+        size_t capacity_;
+        size_t used_;
+        std::ostringstream scratch_;                      // for the types without to_chars
+
+        static const size_t max_number = 128;             // room kept free for one to_chars() result
+
+        void init(size_t);
+        void reserve(size_t);                             // make room for that many bytes in the buffer
+        void emit(const char*, size_t);                   // send bytes to the target
+
+    public:
+        static const size_t default_buffer = size_t(1) << 16;
+
+        explicit ElementWriter(std::ostream&, size_t = default_buffer); // buffer for a stream
+        explicit ElementWriter(int, size_t = default_buffer); // buffer for a file descriptor
+        explicit ElementWriter(std::string&, size_t = default_buffer); // append to a string
+        ~ElementWriter();                                 // hands over the buffer, does not flush, drops errors
+        ElementWriter(const ElementWriter&) = delete;
+        ElementWriter& operator=(const ElementWriter&) = delete;
+
+        void put(const char*, size_t);                    // raw bytes
+        void put(const char*);
+        void put(const std::string&);
+        template<class V>
+        void put(const V&);                               // one element
+
+        template<class Iter>
+        void put_range(Iter, Iter, const char*, const char*); // elements with the separator between them, then the terminator
+
+        void write_out();                                 // hand the buffer over to the target
+        void flush();                                     // write_out(), then flush the stream
+};
+
+inline void ElementWriter::init(size_t capacity) {
+    capacity_ = (capacity < 2 * max_number) ? 2 * max_number : capacity;
+    buffer_.reset(new char[capacity_]);
+    used_ = 0;
+}
+
+inline ElementWriter::ElementWriter(std::ostream& stream, size_t capacity) {
+    stream_ = &stream;
+    fd_ = -1;
+    text_ = nullptr;
+    init(capacity);
+}
+
+inline ElementWriter::ElementWriter(int fd, size_t capacity) {
+    stream_ = nullptr;
+    fd_ = fd;
+    text_ = nullptr;
+    init(capacity);
+}
+
+inline ElementWriter::ElementWriter(std::string& text, size_t capacity) {
+    stream_ = nullptr;
+    fd_ = -1;
+    text_ = &text;
+    init(capacity);
+}
+
+inline ElementWriter::~ElementWriter() {
+    try {
+        write_out();
+    } catch (...) {
+    }
+}
+
+inline void ElementWriter::reserve(size_t bytes) {
+    if (capacity_ - used_ < bytes) {
+        write_out();
+    }
+}
+
+inline void ElementWriter::put(const char* data, size_t bytes) {
+    if (bytes > capacity_ - used_) {
+        write_out();
+        if (bytes >= capacity_) {
+            emit(data, bytes);                            // too large to be worth copying, pass it through
+            return;
+        }
+    }
+    std::memcpy(buffer_.get() + used_, data, bytes);
+    used_ += bytes;
+}
+
+inline void ElementWriter::put(const char* text) {
+    put(text, std::strlen(text));
+}
+
+inline void ElementWriter::put(const std::string& text) {
+    put(text.data(), text.size());
+}
+
+template<class V>
+void ElementWriter::put(const V& val) {
+    if constexpr (std::is_same<V, bool>::value) {
+        put(val ? "1" : "0", 1);
+    } else if constexpr (std::is_same<V, char>::value || std::is_same<V, signed char>::value || std::is_same<V, unsigned char>::value) {
+        char c = char(val);                               // printed as a character, like operator<<
+        put(&c, 1);
+    } else if constexpr (std::is_arithmetic<V>::value) {
+        reserve(max_number);
+        std::to_chars_result r = std::to_chars(buffer_.get() + used_, buffer_.get() + capacity_, val);
+        used_ = size_t(r.ptr - buffer_.get());
+    } else if constexpr (std::is_convertible<const V&, const char*>::value) {
+        put(static_cast<const char*>(val));
+    } else {
+        scratch_.str(std::string());
+        scratch_ << val;
+        put(scratch_.str());
+    }
+}
+
+template<class Iter>
+void ElementWriter::put_range(Iter first, Iter last, const char* separator, const char* terminator) {
+    const size_t separator_size = std::strlen(separator);
+    if (first != last) {
+        put(*first);
+        for (++first; first != last; ++first) {
+            put(separator, separator_size);
+            put(*first);
+        }
+    }
+    put(terminator);
+}
+
+inline void ElementWriter::write_out() {
+    if (used_ != 0) {
+        size_t bytes = used_;
+        used_ = 0;
+        emit(buffer_.get(), bytes);
+    }
+}
+
+inline void ElementWriter::emit(const char* data, size_t bytes) {
+    if (stream_ != nullptr) {
+        stream_->write(data, std::streamsize(bytes));
+    } else if (text_ != nullptr) {
+        text_->append(data, bytes);
+    } else {
+        while (bytes != 0) {
+            ssize_t n = ::write(fd_, data, bytes);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                throw std::runtime_error("cannot write the output");
+            }
+            data += n;
+            bytes -= size_t(n);
+        }
+    }
+}
+
+inline void ElementWriter::flush() {
+    write_out();
+    if (stream_ != nullptr) {
+        stream_->flush();
+    }
+}
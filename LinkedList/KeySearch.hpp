@@ -0,0 +1,242 @@
+// file: KeySearch.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <vector>
+#include "CountingBloomFilter.hpp"
+
+// The query side of find_many(): the positions of many values found in one
+// walk of a list instead of one find() walk per value. The list hands every
+// element to add() in order until done(); positions() then gives, for each
+// query key, the index of its first occurrence or npos.
+//
+// The distinct keys go into a small open-addressing table, so an element costs
+// one probe however many keys there are. Arithmetic elements are copied into a
+// block first and the block is tested with plain loops of fixed length that the
+// compiler vectorizes: against every key when there are at most direct_keys of
+// them, else against the key range; only the elements that pass are probed.
+// Element types without std::hash are compared against every key instead.
+template<class T, class Hash = std::hash<T>>
+class KeySearch {
+    private:
+        static const size_t block_size = 64;
+        static const size_t direct_keys = 16;
+        static const bool arithmetic = std::is_arithmetic<T>::value;
+        static const bool hashable = is_summarizable<T, Hash>::value;
+        typedef typename std::conditional<arithmetic, T, char>::type block_type;
+
+        std::vector<T> keys_;                             // distinct query keys, in query order
+        std::vector<size_t> first_;                       // index of the first occurrence of each distinct key
+        std::vector<uint8_t> settled_;                    // 1 once a distinct key is found or known to be absent
+        std::vector<size_t> query_;                       // distinct key of each query key, npos if it can't match
+        std::vector<uint32_t> table_;                     // distinct key + 1 per slot, 0 for an empty slot
+        size_t remaining_;                                // distinct keys not settled yet
+        size_t seen_;                                     // elements added so far
+        block_type block_[block_size];                    // arithmetic elements waiting for flush()
+        size_t fill_;
+        block_type lo_;                                   // smallest and largest arithmetic key
+        block_type hi_;
+
+        static uint64_t mix(uint64_t);
+        size_t lookup(const T&) const;                    // distinct key equal to the value, npos if none
+        void record(const T&, size_t);                    // note the value seen at that index
+        void flush();                                     // test the buffered block
+
+    public:
+        static const size_t npos = -1;
+
+        KeySearch(const T* keys, size_t count);
+
+        void add(const T&);                               // the next element of the walk
+        bool done() const;                                // true once every key is settled, the walk can stop
+        template<class Pred>
+        void settle_if(Pred);                             // count the pending keys matching pred as absent
+        size_t seen() const;                              // elements added so far
+        std::vector<size_t> positions();                  // index of each query key, npos when absent
+};
+
+template<class T, class Hash>
+const size_t KeySearch<T, Hash>::npos;
+
+template<class T, class Hash>
+KeySearch<T, Hash>::KeySearch(const T* keys, size_t count) {
+    remaining_ = 0;
+    seen_ = 0;
+    fill_ = 0;
+    lo_ = block_type();
+    hi_ = block_type();
+    for (size_t i = 0; i < block_size; i++) {
+        block_[i] = block_type();
+    }
+    if constexpr (hashable) {
+        size_t slots = 8;
+        while (slots < count * 2) {
+            slots *= 2;
+        }
+        table_.assign(slots, 0);
+    }
+    query_.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        const T& key = keys[i];
+        if (!(key == key)) {                              // NaN never compares equal, so it is never found
+            query_.push_back(npos);
+            continue;
+        }
+        size_t d = lookup(key);
+        if (d == npos) {
+            d = keys_.size();
+            keys_.push_back(key);
+            if constexpr (hashable) {
+                size_t mask = table_.size() - 1;
+                size_t slot = size_t(mix(uint64_t(Hash()(key)))) & mask;
+                while (table_[slot] != 0) {
+                    slot = (slot + 1) & mask;
+                }
+                table_[slot] = uint32_t(d + 1);
+            }
+            if constexpr (arithmetic) {
+                if (d == 0 || key < lo_) {
+                    lo_ = key;
+                }
+                if (d == 0 || hi_ < key) {
+                    hi_ = key;
+                }
+            }
+        }
+        query_.push_back(d);
+    }
+    first_.assign(keys_.size(), npos);
+    settled_.assign(keys_.size(), 0);
+    remaining_ = keys_.size();
+}
+
+template<class T, class Hash>
+uint64_t KeySearch<T, Hash>::mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+template<class T, class Hash>
+size_t KeySearch<T, Hash>::lookup(const T& val) const {
+    if constexpr (hashable) {
+        size_t mask = table_.size() - 1;
+        size_t slot = size_t(mix(uint64_t(Hash()(val)))) & mask;
+        while (table_[slot] != 0) {
+            size_t d = table_[slot] - 1;
+            if (keys_[d] == val) {
+                return d;
+            }
+            slot = (slot + 1) & mask;
+        }
+    } else {
+        for (size_t d = 0; d < keys_.size(); d++) {
+            if (keys_[d] == val) {
+                return d;
+            }
+        }
+    }
+    return npos;
+}
+
+template<class T, class Hash>
+void KeySearch<T, Hash>::record(const T& val, size_t index) {
+    size_t d = lookup(val);
+    if (d != npos && settled_[d] == 0) {
+        first_[d] = index;
+        settled_[d] = 1;
+        remaining_--;
+    }
+}
+
+template<class T, class Hash>
+void KeySearch<T, Hash>::flush() {
+    if constexpr (arithmetic) {
+        // whole blocks, so the loops have a fixed trip count; the slots past
+        // fill_ hold stale values and are ignored below
+        uint8_t hit[block_size];
+        if (keys_.size() <= direct_keys) {
+            for (size_t i = 0; i < block_size; i++) {
+                hit[i] = 0;
+            }
+            for (size_t d = 0; d < keys_.size(); d++) {
+                const block_type key = keys_[d];
+                for (size_t i = 0; i < block_size; i++) {
+                    hit[i] |= uint8_t(block_[i] == key);
+                }
+            }
+        } else {
+            const block_type lo = lo_;
+            const block_type hi = hi_;
+            for (size_t i = 0; i < block_size; i++) {
+                hit[i] = uint8_t(!(block_[i] < lo)) & uint8_t(!(hi < block_[i]));
+            }
+        }
+        uint8_t any = 0;
+        for (size_t i = 0; i < block_size; i++) {
+            any |= hit[i];
+        }
+        if (any != 0) {
+            size_t base = seen_ - fill_;
+            for (size_t i = 0; i < fill_ && remaining_ != 0; i++) {
+                if (hit[i] != 0) {
+                    record(block_[i], base + i);
+                }
+            }
+        }
+        fill_ = 0;
+    }
+}
+
+template<class T, class Hash>
+void KeySearch<T, Hash>::add(const T& val) {
+    seen_++;
+    if constexpr (arithmetic) {
+        block_[fill_++] = val;
+        if (fill_ == block_size) {
+            flush();
+        }
+    } else {
+        record(val, seen_ - 1);
+    }
+}
+
+template<class T, class Hash>
+bool KeySearch<T, Hash>::done() const {
+    return remaining_ == 0;
+}
+
+template<class T, class Hash>
+template<class Pred>
+void KeySearch<T, Hash>::settle_if(Pred pred) {
+    for (size_t d = 0; d < keys_.size(); d++) {
+        if (settled_[d] == 0 && pred(keys_[d])) {
+            settled_[d] = 1;
+            remaining_--;
+        }
+    }
+}
+
+template<class T, class Hash>
+size_t KeySearch<T, Hash>::seen() const {
+    return seen_;
+}
+
+template<class T, class Hash>
+std::vector<size_t> KeySearch<T, Hash>::positions() {
+    flush();
+    std::vector<size_t> result(query_.size(), npos);
+    for (size_t i = 0; i < query_.size(); i++) {
+        if (query_[i] != npos) {
+            result[i] = first_[query_[i]];
+        }
+    }
+    return result;
+}
@@ -0,0 +1,1681 @@
+// file: ListCore.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "CountingBloomFilter.hpp"
+#include "ElementWriter.hpp"
+#include "KeySearch.hpp"
+#include "NodeAllocator.hpp"
+#include "NodeHandle.hpp"
+#include "NodeReclaimer.hpp"
+#include "SelfOrganize.hpp"
+
+// The engine behind SinglyLinkedList, DoublyLinkedList and CircularLinkedList.
+// What used to differ between those classes is a policy chosen at compile
+// time, so a list only carries the code of its own policies and nothing is
+// dispatched at run time:
+//
+//     Link        single_link, double_link or circular_link
+//     Organize    static_order, move_to_front_order, ... (SelfOrganize.hpp)
+//     Alloc       hook_allocator, which goes through node_allocator<NodeT>, or
+//                 any class with the same static allocate / deallocate
+//     Size        tracked_size, or untracked_size to drop the counter; size()
+//                 and the index checks then walk the list
+//     Instrument  no_instrument, or count_instrument to count allocations,
+//                 frees, links followed and find() calls, read via stats()
+//     Checkpoint  no_checkpoints, or segment_checkpoints to keep the cut
+//                 points of segments() up to date on every push / pop
+//
+// Every list keeps its front and back node. single_link and circular_link
+// nodes have the same type, so a node_type extracted from one can be pushed
+// into the other. The ring of circular_link is closed through the back node;
+// the operations relinking whole chains open it first and close it after.
+//
+//     typedef list_core::list<int, list_core::single_link, static_order,
+//                             list_core::hook_allocator, list_core::untracked_size> lean_list;
+
+namespace list_core {
+
+struct single_link {                                      // next links, the back node links to nullptr
+    static const bool backward = false;
+    static const bool circular = false;
+    template<class N>
+    struct back_link {};
+    typedef single_link node_link;
+};
+
+struct double_link {                                      // next and prev links
+    static const bool backward = true;
+    static const bool circular = false;
+    template<class N>
+    struct back_link {
+        N* prev;
+    };
+    typedef double_link node_link;
+};
+
+struct circular_link {                                    // next links, the back node links to the front one
+    static const bool backward = false;
+    static const bool circular = true;
+    typedef single_link node_link;                        // same nodes as single_link
+};
+
+struct hook_allocator {                                   // node_allocator<NodeT>, the default
+    template<class NodeT>
+    static void* allocate(size_t size) { return node_allocator<NodeT>::allocate(size); };
+    template<class NodeT>
+    static void deallocate(void* p, size_t size) noexcept { node_allocator<NodeT>::deallocate(p, size); };
+};
+
+struct tracked_size {                                     // one counter, size() in O(1), the default
+    static const bool tracked = true;
+    size_t count_ = 0;
+    void count_add(size_t n) { count_ += n; };
+    void count_sub(size_t n) { count_ -= n; };
+    void count_reset() { count_ = 0; };
+    size_t counted() const { return count_; };
+};
+
+struct untracked_size {                                   // no counter, size() walks the list
+    static const bool tracked = false;
+    void count_add(size_t) {};
+    void count_sub(size_t) {};
+    void count_reset() {};
+    size_t counted() const { return 0; };
+};
+
+struct no_instrument {                                    // nothing recorded, the default
+    void on_allocate() const {};
+    void on_free(size_t) const {};
+    void on_steps(size_t) const {};
+    void on_find() const {};
+};
+
+struct count_instrument {                                 // counters of one list, read through stats()
+    mutable size_t allocations = 0;                       // nodes allocated
+    mutable size_t frees = 0;                             // nodes freed by the list itself
+    mutable size_t steps = 0;                             // links followed by find() and the index walks
+    mutable size_t finds = 0;                             // find() calls that walked the list
+    void on_allocate() const { allocations++; };
+    void on_free(size_t n) const { frees += n; };
+    void on_steps(size_t n) const { steps += n; };
+    void on_find() const { finds++; };
+};
+
+// Whether a cache that const members rebuild on demand is up to date.
+// Mutators set and clear it with plain assignments, they have the list to
+// themselves. Const readers may run at the same time as each other: ensure()
+// lets the first one that finds the cache stale rebuild it while the others
+// wait, and only then reports it up to date.
+class lazy_flag {
+    private:
+        static const uint8_t stale = 0;
+        static const uint8_t building = 1;
+        static const uint8_t ready = 2;
+        mutable std::atomic<uint8_t> state_;
+
+    public:
+        lazy_flag(bool valid = true) : state_(valid ? ready : stale) {};
+        lazy_flag(const lazy_flag& other) : state_(other.state_.load(std::memory_order_acquire)) {};
+        lazy_flag& operator=(const lazy_flag& other) { state_.store(other.state_.load(std::memory_order_acquire), std::memory_order_release); return *this; };
+        lazy_flag& operator=(bool valid) { state_.store(valid ? ready : stale, std::memory_order_release); return *this; };
+        operator bool() const { return state_.load(std::memory_order_acquire) == ready; };
+        template<class Rebuild>
+        void ensure(Rebuild) const;                       // run rebuild once if stale, wait for it if another reader is
+};
+
+template<class Rebuild>
+void lazy_flag::ensure(Rebuild rebuild) const {
+    uint8_t state = state_.load(std::memory_order_acquire);
+    while (state != ready) {
+        if (state == stale && state_.compare_exchange_weak(state, building, std::memory_order_acquire)) {
+            try {
+                rebuild();
+            } catch (...) {
+                state_.store(stale, std::memory_order_release);
+                throw;
+            }
+            state_.store(ready, std::memory_order_release);
+            return;
+        }
+        if (state == building) {
+            std::this_thread::yield();
+            state = state_.load(std::memory_order_acquire);
+        }
+    }
+}
+
+struct no_checkpoints {                                   // segments() walks the list, the default
+    static const bool kept = false;
+    template<class N>
+    struct state {};
+};
+
+struct segment_checkpoints {                              // segments() in O(size / segment_length), kept up by every push / pop
+    static const bool kept = true;
+    // roughly every segment_length-th node, in list order. front_checkpoints_
+    // holds the ones added by push_front, nearest to the front last;
+    // back_checkpoints_ the rest in list order
+    template<class N>
+    struct state {
+        mutable std::vector<N*> front_checkpoints_;
+        mutable std::vector<N*> back_checkpoints_;
+        mutable lazy_flag checkpoints_valid_;
+        mutable size_t front_run_ = 0;                    // nodes pushed at the front since the last checkpoint there
+        mutable size_t back_run_ = 0;                     // nodes pushed at the back since the last checkpoint there
+    };
+};
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint> class list;
+
+template<class T, class Link, class Organize, class Alloc>
+class node : public Organize::node_base, public Link::template back_link<node<T, Link, Organize, Alloc>> {
+    private:
+        T val;
+        node<T, Link, Organize, Alloc>* next;
+    public:
+        node(const T& _val) : val(_val), next(nullptr) {};
+        node(const T&& _val) : val(_val), next(nullptr) {};
+        static void* operator new(size_t size) { return Alloc::template allocate<node<T, Link, Organize, Alloc>>(size); };
+        static void operator delete(void* p, size_t size) { Alloc::template deallocate<node<T, Link, Organize, Alloc>>(p, size); };
+        template<class, class, class, class, class, class, class> friend class list;
+        template<class, class> friend class ::node_handle;
+};
+
+template<class T, class Link, class Organize = static_order, class Alloc = hook_allocator, class Size = tracked_size, class Instrument = no_instrument, class Checkpoint = no_checkpoints>
+class list : private Size, private Instrument, private Checkpoint::template state<node<T, typename Link::node_link, Organize, Alloc>> {
+    private:
+        typedef node<T, typename Link::node_link, Organize, Alloc> Node;
+        typedef typename Checkpoint::template state<Node> checkpoint_state;
+
+        Node* head_;
+        Node* tail_;
+
+        // Segment checkpoints for splitting the list without walking it, only
+        // with the segment_checkpoints policy (the checkpoint_state base). Kept
+        // up to date in O(1) by the push / pop functions, rebuilt lazily by
+        // segments() after operations that relink many nodes; concurrent const
+        // segments() calls share one rebuild through checkpoints_valid_.
+        // With no_checkpoints these functions do nothing.
+        void checkpoint_front();                          // bookkeeping after a push at the front
+        void checkpoint_back();                           // bookkeeping after a push at the back
+        void uncheckpoint(Node*);                         // bookkeeping before a node is unlinked
+        void invalidate_checkpoints();                    // after relinking many nodes, rebuilt by the next segments()
+        void rebuild_checkpoints() const;
+
+        // Optional membership summary, see enable_summary(). Kept up to date
+        // by the push / insert / pop / remove functions, rebuilt lazily by
+        // find() after operations that relink many nodes; concurrent const
+        // find() calls share one rebuild through summary_valid_.
+        mutable std::unique_ptr<CountingBloomFilter<T>> summary_;
+        mutable lazy_flag summary_valid_;
+
+        void summary_add(const T&);                       // bookkeeping after a value is linked in
+        void summary_remove(const T&);                    // bookkeeping before a value is unlinked
+        bool summary_excludes(const T&) const;            // true if the value is definitely not in the list
+        void rebuild_summary() const;
+
+        // Chains detached by clear() in reclaim_incremental mode, each ending
+        // in a nullptr next link, freed a few nodes per operation.
+        std::vector<Node*> garbage_;
+        size_t garbage_size_;                             // nodes in garbage_
+        reclaim_mode reclaim_mode_;
+        size_t reclaim_step_;                             // nodes freed per operation while garbage_ is not empty
+
+        void reclaim_some();                              // bookkeeping at the start of a push / insert / pop / remove
+        static void* dispose_chain(void*, size_t);        // delete up to that many nodes of a detached chain, return the rest
+
+        // Every link change goes through these, so the Link policy is handled
+        // in one place.
+        Node* make_node(const T&);                        // allocate a node, counted by the Instrument
+        void free_node(Node*);                            // delete a node, counted by the Instrument
+        void free_chain(Node*);                           // delete a chain ending in nullptr
+        Node* next_of(const Node*) const;                 // next node in list order, nullptr after the back
+        Node* before(size_t) const;                       // node in front of the index, nullptr for 0
+        Node* prev_of(Node*) const;                       // node in front of a linked node, nullptr for the front
+        void link_after(Node*, Node*);                    // link a node in behind another one, nullptr for the front
+        void unlink_after(Node*, Node*);                  // unlink a node given the one in front of it
+        void attach(Node*, Node*);                        // link_after() with the size / summary / checkpoint bookkeeping
+        void detach(Node*, Node*);                        // unlink_after() with the size / summary / checkpoint bookkeeping
+        void seal();                                      // circular_link: close the ring through the back node
+        void unseal();                                    // circular_link: end the chain at the back node
+
+        size_t find_and_organize(const T&, static_order); // find() for each Organize policy
+        size_t find_and_organize(const T&, move_to_front_order);
+        size_t find_and_organize(const T&, transpose_order);
+        size_t find_and_organize(const T&, count_order);
+
+    public:
+        static const size_t npos = -1;
+        static const size_t segment_length = 4096;        // nodes per segment returned by segments()
+
+        template<class U>
+        class basic_iterator {                            // forward iterator, bidirectional with double_link; U is T or const T
+            private:
+                Node* node_;
+                const list* list_;                        // steps past the back of a ring and back from end()
+                template<class> friend class basic_iterator;
+            public:
+                typedef typename std::conditional<Link::backward, std::bidirectional_iterator_tag, std::forward_iterator_tag>::type iterator_category;
+                typedef T value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef U* pointer;
+                typedef U& reference;
+
+                basic_iterator() : node_(nullptr), list_(nullptr) {};
+                basic_iterator(Node* node, const list* owner) : node_(node), list_(owner) {};
+                basic_iterator(const basic_iterator<T>& other) : node_(other.node_), list_(other.list_) {};
+
+                reference operator*() const { return node_->val; };
+                pointer operator->() const { return &node_->val; };
+                basic_iterator& operator++() { node_ = list_->next_of(node_); return *this; };
+                basic_iterator operator++(int) { basic_iterator old = *this; ++*this; return old; };
+                basic_iterator& operator--() { node_ = (node_ == nullptr) ? list_->tail_ : node_->prev; return *this; }; // double_link only
+                basic_iterator operator--(int) { basic_iterator old = *this; --*this; return old; };
+                bool operator==(const basic_iterator& other) const { return node_ == other.node_; };
+                bool operator!=(const basic_iterator& other) const { return node_ != other.node_; };
+        };
+        typedef basic_iterator<T> iterator;
+        typedef basic_iterator<const T> const_iterator;
+        typedef node_handle<T, Node> node_type;           // owning handle returned by extract()
+
+        list();                                           // constructor
+        ~list();                                          // destructor
+        list(const list&) = delete;
+        list& operator=(const list&) = delete;
+        list(list&&) noexcept;                            // move constructor, takes over the nodes in O(1)
+        list& operator=(list&&) noexcept;                 // move assignment
+        void swap(list&) noexcept;                        // exchange the contents in O(1)
+
+        T& front();                                       // return head element
+        T& back();                                        // return tail element
+        void clear();                                     // make the linked List to empty
+        void set_reclaim_mode(reclaim_mode, size_t = 64); // how clear() and the destructor free the nodes, and how many per operation
+        void reclaim(size_t = npos);                      // free up to that many nodes detached by clear() now
+        size_t pending_reclaim() const;                   // nodes detached by clear() and not freed yet
+
+        iterator begin();                                 // iterator to the front element
+        iterator end();                                   // iterator past the last element
+        const_iterator begin() const;                     // overloading begin()
+        const_iterator end() const;                       // overloading end()
+
+        std::vector<iterator> segments();                 // start of each segment, the last one ends at end(); walks the list without segment_checkpoints
+        std::vector<const_iterator> segments() const;     // overloading segments()
+
+        void push_front(const T&);                        // insert element to front of Linked list
+        void push_front(const T&&);                       // overloading push_front()
+        void push_front(node_type&&);                     // link an extracted node in at the front, no allocation
+
+        void push_back(const T&);                         // insert element to end of Linked list
+        void push_back(const T&&);                        // overloading push_back()
+        void push_back(node_type&&);                      // link an extracted node in at the end, no allocation
+
+        void pop_front();                                 // remove the front element in Linked list
+
+        void pop_back();                                  // remove the end elemnt in Linked list, walks the list without double_link
+
+        size_t find(const T&) const;                      // check the value is exit in the linked list and return the index
+        size_t find(const T&&) const;                     // overloading find()
+        size_t find(const T&);                            // find() const, then reorder by the Organize policy
+        size_t find(const T&&);                           // overloading find()
+        std::vector<size_t> find_many(const T*, size_t) const; // find() const of each key in one walk, npos when absent
+
+        // With a summary, find() returns npos without walking the list for
+        // most values that are absent. It costs about 4.8 bytes per element at
+        // a 1% false positive rate and one hash per push / insert / pop / remove.
+        // Assigning to an element through front(), an iterator or segments()
+        // bypasses the summary; call enable_summary() again after doing that.
+        void enable_summary(size_t, double = 0.01, size_t = 0); // summary sized for that many elements, false positive rate and byte cap (0 = none)
+        void disable_summary();                           // drop the summary
+        size_t summary_bytes() const;                     // bytes held by the summary, 0 without one
+
+        void insert(const T&, const size_t&);             // insert elements according to the index
+        void insert(const T&, const size_t&&);            // overloading insert()
+        void insert(const T&&, const size_t&);            // overloading insert()
+        void insert(const T&&, const size_t&&);           // overloading insert()
+        void insert(node_type&&, const size_t&);          // link an extracted node in at the index, no allocation
+
+        void remove(const size_t&);                       // remove element by index
+        void remove(const size_t&&);                      // overloading remove()
+        node_type extract(const size_t&);                 // unlink the element at the index and hand its node over
+        size_t remove_value(const T&);                    // remove every element equal to the value in one pass, return the count
+        template<class Pred>
+        size_t remove_if(Pred);                           // remove every element matching pred in one pass, return the count
+
+        enum edit_op { insert_op, remove_op };
+        struct edit {                                     // one entry of an apply_batch() batch
+            size_t index;                                 // position in the list as it was before the batch
+            edit_op op;
+            T val;                                        // unused by remove_op
+        };
+        void apply_batch(const std::vector<edit>&);       // apply the edits in one traversal, all or nothing
+
+        void reverse();                                   // reverse the Linked list
+        void advance();                                   // circular_link: the front element becomes the back one
+
+        // the operations below expect both Linked lists sorted in ascending order
+        // and follow std::merge / std::set_* semantics for repeated elements
+        void merge(list&);                                // merge all nodes of the other list into this one, the other becomes empty
+        void merge(std::vector<list*>&);                  // k-way merge of the lists into this one in O(N log k), they become empty
+        void set_union(list&);                            // relink the missing nodes of the other list into this one, the other becomes empty
+        void set_intersection(const list&);               // keep only the elements that are also in the other list
+        void set_difference(const list&);                 // drop the elements that are also in the other list
+
+        size_t size() const;                              // return size of Linked list;
+        bool empty() const;                               // check the Linked list is empty
+        const Instrument& stats() const;                  // what the Instrument policy recorded
+        void write_to(ElementWriter&, const char* = " ", const char* = "\n") const; // the elements, the separator between them, then the terminator
+        void write_to(std::ostream&, const char* = " ", const char* = "\n") const; // buffered write to the stream, does not flush it
+        void write_to(int, const char* = " ", const char* = "\n") const; // buffered write to the file descriptor, one write() per buffer
+        void print() const;                               // print the elements of Linked list from front to end
+        void print_reverse() const;                       // double_link: print the elements of Linked list from end to front
+};
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::list() {
+    head_ = nullptr;
+    tail_ = nullptr;
+    summary_valid_ = true;
+    garbage_size_ = 0;
+    reclaim_mode_ = reclaim_immediate;
+    reclaim_step_ = 64;
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::~list() {
+    clear();
+    for (Node* chain : garbage_) {
+        if (reclaim_mode_ == reclaim_immediate) {
+            dispose_chain(chain, npos);
+        } else {
+            NodeReclaimer::retire(chain, &dispose_chain);
+        }
+    }
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::list(list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>&& other) noexcept : list() {
+    swap(other);
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>& list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::operator=(list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>&& other) noexcept {
+    if (this != &other) {
+        clear();
+        swap(other);
+    }
+    return *this;
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::swap(list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>& other) noexcept {
+    std::swap(head_, other.head_);
+    std::swap(tail_, other.tail_);
+    std::swap(static_cast<Size&>(*this), static_cast<Size&>(other));
+    std::swap(static_cast<checkpoint_state&>(*this), static_cast<checkpoint_state&>(other));
+    std::swap(summary_, other.summary_);
+    std::swap(summary_valid_, other.summary_valid_);
+    std::swap(garbage_, other.garbage_);
+    std::swap(garbage_size_, other.garbage_size_);
+    std::swap(reclaim_mode_, other.reclaim_mode_);
+    std::swap(reclaim_step_, other.reclaim_step_);
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void swap(list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>& a, list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>& b) noexcept {
+    a.swap(b);
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+T& list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::front() {
+    return head_->val;
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+T& list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::back() {
+    return tail_->val;
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::clear() {
+    unseal();
+    if (reclaim_mode_ == reclaim_incremental && head_ != nullptr) {
+        garbage_size_ += size();
+        garbage_.push_back(head_);
+        head_ = nullptr;
+    } else if (reclaim_mode_ == reclaim_background) {
+        NodeReclaimer::retire(head_, &dispose_chain);
+        head_ = nullptr;
+    }
+    free_chain(head_);
+    head_ = nullptr;
+    tail_ = nullptr;
+    this->count_reset();
+    static_cast<checkpoint_state&>(*this) = checkpoint_state();
+    if (summary_) {
+        summary_->clear();
+    }
+    summary_valid_ = true;
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+typename list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::iterator list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::begin() {
+    return iterator(head_, this);
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+typename list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::iterator list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::end() {
+    return iterator(nullptr, this);
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+typename list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::const_iterator list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::begin() const {
+    return const_iterator(head_, this);
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+typename list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::const_iterator list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::end() const {
+    return const_iterator(nullptr, this);
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+typename list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::Node* list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::make_node(const T& val) {
+    Node* node = new Node(val);
+    this->on_allocate();
+    return node;
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::free_node(Node* node) {
+    delete node;
+    this->on_free(1);
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::free_chain(Node* chain) {
+    while (chain != nullptr) {
+        Node* del_node = chain;
+        chain = chain->next;
+        free_node(del_node);
+    }
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+typename list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::Node* list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::next_of(const Node* node) const {
+    if constexpr (Link::circular) {
+        return (node == tail_) ? nullptr : node->next;
+    } else {
+        return node->next;
+    }
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+typename list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::Node* list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::before(size_t index) const {
+    if (index == 0) {
+        return nullptr;
+    }
+    if constexpr (Size::tracked) {
+        size_t count = this->counted();
+        if (index == count) {
+            return tail_;
+        }
+        if constexpr (Link::backward) {
+            if (index > count / 2) {                      // nearer to the back, walk the prev links
+                Node* prev = tail_;
+                for (size_t i = count; i > index; i--) {
+                    prev = prev->prev;
+                }
+                this->on_steps(count - index);
+                return prev;
+            }
+        }
+    }
+    Node* prev = head_;
+    for (size_t i = 1; i < index; i++) {
+        prev = prev->next;
+    }
+    this->on_steps(index - 1);
+    return prev;
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+typename list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::Node* list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::prev_of(Node* node) const {
+    if constexpr (Link::backward) {
+        return node->prev;
+    } else {
+        if (node == head_) {
+            return nullptr;
+        }
+        Node* prev = head_;
+        size_t steps = 0;
+        while (prev->next != node) {
+            prev = prev->next;
+            steps++;
+        }
+        this->on_steps(steps);
+        return prev;
+    }
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::link_after(Node* prev, Node* node) {
+    if (prev == nullptr) {
+        node->next = head_;
+        head_ = node;
+    } else {
+        node->next = prev->next;
+        prev->next = node;
+    }
+    if constexpr (Link::backward) {
+        node->prev = prev;
+    }
+    if (prev == tail_) {
+        tail_ = node;
+    } else if constexpr (Link::backward) {
+        node->next->prev = node;
+    }
+    seal();
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::unlink_after(Node* prev, Node* node) {
+    Node* next = next_of(node);
+    if (prev == nullptr) {
+        head_ = next;
+    } else {
+        prev->next = next;
+    }
+    if (node == tail_) {
+        tail_ = prev;
+    } else if constexpr (Link::backward) {
+        next->prev = prev;
+    }
+    seal();
+    node->next = nullptr;
+    if constexpr (Link::backward) {
+        node->prev = nullptr;
+    }
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::attach(Node* prev, Node* node) {
+    link_after(prev, node);
+    this->count_add(1);
+    summary_add(node->val);
+    if (prev == nullptr) {
+        checkpoint_front();
+    } else if (node == tail_) {
+        checkpoint_back();
+    }
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::detach(Node* prev, Node* node) {
+    summary_remove(node->val);
+    uncheckpoint(node);
+    unlink_after(prev, node);
+    this->count_sub(1);
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::seal() {
+    if constexpr (Link::circular) {
+        if (tail_ != nullptr) {
+            tail_->next = head_;
+        }
+    }
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::unseal() {
+    if constexpr (Link::circular) {
+        if (tail_ != nullptr) {
+            tail_->next = nullptr;
+        }
+    }
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::push_front(const T& val) {
+    reclaim_some();
+    attach(nullptr, make_node(val));
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::push_front(const T&& val) {
+    push_front(val);
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::push_front(node_type&& node) {
+    reclaim_some();
+    Node* new_head = node.release();
+    if (new_head != nullptr) {
+        attach(nullptr, new_head);
+    }
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::push_back(const T& val) {
+    reclaim_some();
+    attach(tail_, make_node(val));
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::push_back(const T&& val) {
+    push_back(val);
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::push_back(node_type&& node) {
+    reclaim_some();
+    Node* new_tail = node.release();
+    if (new_tail != nullptr) {
+        attach(tail_, new_tail);
+    }
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::pop_front() {
+    reclaim_some();
+    if (head_ != nullptr) {
+        Node* del_node = head_;
+        detach(nullptr, del_node);
+        free_node(del_node);
+    }
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::pop_back() {
+    reclaim_some();
+    if (tail_ != nullptr) {
+        Node* del_node = tail_;
+        detach(prev_of(del_node), del_node);
+        free_node(del_node);
+    }
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+size_t list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::find(const T& val) const {
+    if (summary_excludes(val)) {
+        return npos;
+    }
+    this->on_find();
+    size_t index = 0;
+    const Node* curr = head_;
+    while (curr != nullptr && curr->val != val) {
+        curr = next_of(curr);
+        index++;
+    }
+    this->on_steps(index);
+    return (curr == nullptr) ? npos : index;
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+size_t list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::find(const T&& val) const {
+    return find(val);
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+std::vector<size_t> list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::find_many(const T* keys, size_t count) const {
+    KeySearch<T> search(keys, count);
+    if (summary_) {
+        search.settle_if([this](const T& val) { return summary_excludes(val); });
+    }
+    if (!search.done()) {
+        this->on_find();
+        for (const Node* curr = head_; curr != nullptr && !search.done(); curr = next_of(curr)) {
+            search.add(curr->val);
+        }
+        this->on_steps(search.seen());
+    }
+    return search.positions();
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+size_t list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::find(const T& val) {
+    return find_and_organize(val, Organize());
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+size_t list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::find(const T&& val) {
+    return find(val);
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+size_t list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::find_and_organize(const T& val, static_order) {
+    return static_cast<const list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>&>(*this).find(val);
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+size_t list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::find_and_organize(const T& val, move_to_front_order) {
+    if (summary_excludes(val)) {
+        return npos;
+    }
+    this->on_find();
+    size_t index = 0;
+    Node* prev = nullptr;
+    Node* curr = head_;
+    while (curr != nullptr && curr->val != val) {
+        prev = curr;
+        curr = next_of(curr);
+        index++;
+    }
+    this->on_steps(index);
+    if (curr == nullptr) {
+        return npos;
+    }
+    if (prev != nullptr) {
+        unlink_after(prev, curr);
+        link_after(nullptr, curr);
+        invalidate_checkpoints();
+    }
+    return index;
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+size_t list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::find_and_organize(const T& val, transpose_order) {
+    if (summary_excludes(val)) {
+        return npos;
+    }
+    this->on_find();
+    size_t index = 0;
+    Node* pprev = nullptr;
+    Node* prev = nullptr;
+    Node* curr = head_;
+    while (curr != nullptr && curr->val != val) {
+        pprev = prev;
+        prev = curr;
+        curr = next_of(curr);
+        index++;
+    }
+    this->on_steps(index);
+    if (curr == nullptr) {
+        return npos;
+    }
+    if (prev != nullptr) {
+        unlink_after(prev, curr);
+        link_after(pprev, curr);
+        invalidate_checkpoints();
+    }
+    return index;
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+size_t list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::find_and_organize(const T& val, count_order) {
+    if (summary_excludes(val)) {
+        return npos;
+    }
+    this->on_find();
+    size_t index = 0;
+    Node* group_prev = nullptr;                           // node in front of the run with curr's hit count
+    Node* prev = nullptr;
+    Node* curr = head_;
+    while (curr != nullptr && curr->val != val) {
+        prev = curr;
+        curr = next_of(curr);
+        index++;
+        if (curr != nullptr && curr->hits != prev->hits) {
+            group_prev = prev;
+        }
+    }
+    this->on_steps(index);
+    if (curr == nullptr) {
+        return npos;
+    }
+    if (curr->hits != UINT32_MAX) {
+        curr->hits++;
+    }
+    // the first node of the run still has at most the new count, go in front of it
+    Node* group_first = (group_prev == nullptr) ? head_ : group_prev->next;
+    if (group_first != curr) {
+        unlink_after(prev, curr);
+        link_after(group_prev, curr);
+        invalidate_checkpoints();
+    }
+    return index;
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::insert(const T& val, const size_t& index) {
+    reclaim_some();
+    if (index > size()) {
+        throw std::overflow_error("the index overflow error");
+    }
+    attach(before(index), make_node(val));
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::insert(const T& val, const size_t&& index) {
+    insert(val, index);
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::insert(const T&& val, const size_t& index) {
+    insert(val, index);
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::insert(const T&& val, const size_t&& index) {
+    insert(val, index);
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::insert(node_type&& node, const size_t& index) {
+    reclaim_some();
+    if (index > size()) {
+        throw std::overflow_error("the index overflow error");
+    }
+    if (!node.empty()) {
+        attach(before(index), node.release());
+    }
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::remove(const size_t& index) {
+    reclaim_some();
+    if (index >= size()) {
+        throw std::overflow_error("The index is overflow");
+    }
+    Node* prev = before(index);
+    Node* curr = (prev == nullptr) ? head_ : prev->next;
+    detach(prev, curr);
+    free_node(curr);
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::remove(const size_t&& index) {
+    remove(index);
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+typename list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::node_type list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::extract(const size_t& index) {
+    reclaim_some();
+    if (index >= size()) {
+        throw std::overflow_error("The index is overflow");
+    }
+    Node* prev = before(index);
+    Node* curr = (prev == nullptr) ? head_ : prev->next;
+    detach(prev, curr);
+    return node_type(curr);
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+size_t list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::remove_value(const T& val) {
+    return remove_if([&val](const T& x) { return x == val; });
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+template<class Pred>
+size_t list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::remove_if(Pred pred) {
+    unseal();
+    Node* removed = nullptr;                              // unlinked nodes, freed after the walk
+    Node* last = nullptr;                                 // last node kept
+    Node* curr = head_;
+    size_t count = 0;
+    while (curr != nullptr) {
+        Node* next = curr->next;
+        bool matched;
+        try {
+            matched = pred(curr->val);
+        } catch (...) {
+            // keep what was removed so far, curr and the nodes after it stay
+            if constexpr (Link::backward) {
+                curr->prev = last;
+            }
+            seal();
+            if (count != 0) {
+                invalidate_checkpoints();
+                summary_valid_ = false;
+            }
+            free_chain(removed);
+            throw;
+        }
+        if (matched) {
+            if (last == nullptr) {
+                head_ = next;
+            } else {
+                last->next = next;
+            }
+            curr->next = removed;
+            removed = curr;
+            this->count_sub(1);
+            count++;
+        } else {
+            if constexpr (Link::backward) {
+                curr->prev = last;
+            }
+            last = curr;
+        }
+        curr = next;
+    }
+    tail_ = last;
+    seal();
+    if (count != 0) {
+        invalidate_checkpoints();
+        summary_valid_ = false;
+    }
+    free_chain(removed);
+    return count;
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint, class Pred>
+size_t erase_if(list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>& list, Pred pred) {
+    return list.remove_if(pred);
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::apply_batch(const std::vector<edit>& edits) {
+    // sort by position, edits at the same index keep their batch order with inserts first
+    std::vector<size_t> order(edits.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&edits](size_t a, size_t b) {
+        if (edits[a].index != edits[b].index) {
+            return edits[a].index < edits[b].index;
+        }
+        return edits[a].op == insert_op && edits[b].op == remove_op;
+    });
+
+    // validate and allocate everything before the list is touched
+    const size_t count = size();
+    size_t inserts = 0;
+    for (size_t k = 0; k < order.size(); k++) {
+        const edit& e = edits[order[k]];
+        if (e.op == insert_op) {
+            if (e.index > count) {
+                throw std::overflow_error("the index overflow error");
+            }
+            inserts++;
+        } else {
+            if (e.index >= count) {
+                throw std::overflow_error("The index is overflow");
+            }
+            if (k > 0 && edits[order[k - 1]].op == remove_op && edits[order[k - 1]].index == e.index) {
+                throw std::invalid_argument("the element is removed twice");
+            }
+        }
+    }
+    std::vector<Node*> created;
+    created.reserve(inserts);
+    try {
+        for (size_t k : order) {
+            if (edits[k].op == insert_op) {
+                created.push_back(make_node(edits[k].val));
+            }
+        }
+    } catch (...) {
+        for (Node* node : created) {
+            free_node(node);
+        }
+        throw;
+    }
+
+    // one forward walk, pos is the index of curr before the batch
+    unseal();
+    Node* removed = nullptr;                              // unlinked nodes, freed after the walk
+    Node* last = nullptr;                                 // last node of the edited list so far
+    Node* curr = head_;
+    size_t pos = 0;
+    size_t made = 0;
+    for (size_t k : order) {
+        const edit& e = edits[k];
+        while (pos < e.index) {
+            last = curr;
+            curr = curr->next;
+            pos++;
+        }
+        if (e.op == insert_op) {
+            Node* insert_node = created[made++];
+            insert_node->next = curr;
+            if constexpr (Link::backward) {
+                insert_node->prev = last;
+            }
+            if (last == nullptr) {
+                head_ = insert_node;
+            } else {
+                last->next = insert_node;
+            }
+            if (curr == nullptr) {
+                tail_ = insert_node;
+            } else if constexpr (Link::backward) {
+                curr->prev = insert_node;
+            }
+            last = insert_node;
+            this->count_add(1);
+        } else {
+            Node* next = curr->next;
+            if (last == nullptr) {
+                head_ = next;
+            } else {
+                last->next = next;
+            }
+            if (next == nullptr) {
+                tail_ = last;
+            } else if constexpr (Link::backward) {
+                next->prev = last;
+            }
+            curr->next = removed;
+            removed = curr;
+            curr = next;
+            pos++;
+            this->count_sub(1);
+        }
+    }
+    seal();
+    this->on_steps(pos);
+    if (!edits.empty()) {
+        invalidate_checkpoints();
+        summary_valid_ = false;
+    }
+    free_chain(removed);
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::reverse() {
+    unseal();
+    Node* prev = nullptr;
+    Node* curr = head_;
+    while (curr != nullptr) {
+        Node* next = curr->next;
+        curr->next = prev;
+        if constexpr (Link::backward) {
+            curr->prev = next;
+        }
+        prev = curr;
+        curr = next;
+    }
+    tail_ = head_;
+    head_ = prev;
+    seal();
+    if constexpr (Checkpoint::kept) {
+        this->front_checkpoints_.swap(this->back_checkpoints_);
+        std::swap(this->front_run_, this->back_run_);
+    }
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::advance() {
+    static_assert(Link::circular, "advance() needs the circular_link policy");
+    if (tail_ != nullptr) {
+        tail_ = head_;
+        head_ = head_->next;
+        invalidate_checkpoints();
+    }
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::merge(list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>& other) {
+    if (&other == this) {
+        return;
+    }
+    invalidate_checkpoints();
+    summary_valid_ = false;
+    this->count_add(other.size());
+    unseal();
+    other.unseal();
+    Node* a = head_;
+    Node* b = other.head_;
+    Node* last = nullptr;
+    while (a != nullptr && b != nullptr) {
+        Node* take;
+        if (b->val < a->val) {
+            take = b;
+            b = b->next;
+        } else {
+            take = a;
+            a = a->next;
+        }
+        if constexpr (Link::backward) {
+            take->prev = last;
+        }
+        if (last == nullptr) {
+            head_ = take;
+        } else {
+            last->next = take;
+        }
+        last = take;
+    }
+    Node* rest = (a != nullptr) ? a : b;
+    if (rest != nullptr) {
+        if constexpr (Link::backward) {
+            rest->prev = last;
+        }
+        if (last == nullptr) {
+            head_ = rest;
+        } else {
+            last->next = rest;
+        }
+        if (rest == b) {
+            tail_ = other.tail_;
+        }
+    } else {
+        tail_ = last;
+    }
+    seal();
+    other.head_ = nullptr;
+    other.tail_ = nullptr;
+    other.count_reset();
+    other.invalidate_checkpoints();
+    other.summary_valid_ = false;
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::merge(std::vector<list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>*>& lists) {
+    // heap entry: (first unmerged node of a run, run number); equal values keep run order
+    typedef std::pair<Node*, size_t> entry;
+    struct later {
+        bool operator()(const entry& x, const entry& y) const {
+            if (y.first->val < x.first->val) {
+                return true;
+            }
+            if (x.first->val < y.first->val) {
+                return false;
+            }
+            return x.second > y.second;
+        }
+    };
+    std::vector<entry> runs;
+    std::vector<Node*> tails;
+    runs.reserve(lists.size() + 1);
+    tails.reserve(lists.size() + 1);
+    unseal();
+    tails.push_back(tail_);
+    if (head_ != nullptr) {
+        runs.push_back(entry(head_, 0));
+    }
+    for (size_t i = 0; i < lists.size(); i++) {
+        list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>* other = lists[i];
+        tails.push_back(nullptr);
+        if (other != this && other->head_ != nullptr) {
+            this->count_add(other->size());
+            other->unseal();
+            runs.push_back(entry(other->head_, i + 1));
+            tails[i + 1] = other->tail_;
+            other->head_ = nullptr;
+            other->tail_ = nullptr;
+            other->count_reset();
+            other->invalidate_checkpoints();
+            other->summary_valid_ = false;
+        }
+    }
+    std::priority_queue<entry, std::vector<entry>, later> heap(later(), std::move(runs));
+
+    invalidate_checkpoints();
+    summary_valid_ = false;
+    head_ = nullptr;
+    tail_ = nullptr;
+    Node* last = nullptr;
+    while (!heap.empty()) {
+        Node* take = heap.top().first;
+        size_t run = heap.top().second;
+        heap.pop();
+        if constexpr (Link::backward) {
+            take->prev = last;
+        }
+        if (last == nullptr) {
+            head_ = take;
+        } else {
+            last->next = take;
+        }
+        last = take;
+        if (heap.empty()) {
+            tail_ = tails[run];                           // the last run is already linked
+            break;
+        }
+        if (take->next != nullptr) {
+            heap.push(entry(take->next, run));
+        }
+    }
+    seal();
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::set_union(list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>& other) {
+    if (&other == this) {
+        return;
+    }
+    invalidate_checkpoints();
+    summary_valid_ = false;
+    unseal();
+    other.unseal();
+    Node* a = head_;
+    Node* b = other.head_;
+    Node* last = nullptr;
+    while (a != nullptr && b != nullptr) {
+        Node* take;
+        if (b->val < a->val) {
+            take = b;
+            b = b->next;
+            this->count_add(1);
+        } else {
+            if (!(a->val < b->val)) {
+                Node* del_node = b;
+                b = b->next;
+                free_node(del_node);
+            }
+            take = a;
+            a = a->next;
+        }
+        if constexpr (Link::backward) {
+            take->prev = last;
+        }
+        if (last == nullptr) {
+            head_ = take;
+        } else {
+            last->next = take;
+        }
+        last = take;
+    }
+    Node* rest = (a != nullptr) ? a : b;
+    if (rest != nullptr) {
+        if constexpr (Link::backward) {
+            rest->prev = last;
+        }
+        if (last == nullptr) {
+            head_ = rest;
+        } else {
+            last->next = rest;
+        }
+        if (rest == b) {
+            tail_ = other.tail_;
+        }
+    } else {
+        tail_ = last;
+    }
+    if constexpr (Size::tracked) {
+        while (b != nullptr) {
+            this->count_add(1);
+            b = b->next;
+        }
+    }
+    seal();
+    other.head_ = nullptr;
+    other.tail_ = nullptr;
+    other.count_reset();
+    other.invalidate_checkpoints();
+    other.summary_valid_ = false;
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::set_intersection(const list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>& other) {
+    if (&other == this) {
+        return;
+    }
+    invalidate_checkpoints();
+    summary_valid_ = false;
+    unseal();
+    Node* a = head_;
+    const Node* b = other.head_;
+    Node* last = nullptr;
+    head_ = nullptr;
+    while (a != nullptr) {
+        if (b != nullptr && b->val < a->val) {
+            b = other.next_of(b);
+        } else if (b == nullptr || a->val < b->val) {
+            Node* del_node = a;
+            a = a->next;
+            free_node(del_node);
+            this->count_sub(1);
+        } else {
+            if constexpr (Link::backward) {
+                a->prev = last;
+            }
+            if (last == nullptr) {
+                head_ = a;
+            } else {
+                last->next = a;
+            }
+            last = a;
+            a = a->next;
+            b = other.next_of(b);
+        }
+    }
+    if (last != nullptr) {
+        last->next = nullptr;
+    }
+    tail_ = last;
+    seal();
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::set_difference(const list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>& other) {
+    if (&other == this) {
+        clear();
+        return;
+    }
+    invalidate_checkpoints();
+    summary_valid_ = false;
+    unseal();
+    Node* a = head_;
+    const Node* b = other.head_;
+    Node* last = nullptr;
+    head_ = nullptr;
+    while (a != nullptr) {
+        if (b != nullptr && b->val < a->val) {
+            b = other.next_of(b);
+        } else if (b != nullptr && !(a->val < b->val)) {
+            Node* del_node = a;
+            a = a->next;
+            b = other.next_of(b);
+            free_node(del_node);
+            this->count_sub(1);
+        } else {
+            if constexpr (Link::backward) {
+                a->prev = last;
+            }
+            if (last == nullptr) {
+                head_ = a;
+            } else {
+                last->next = a;
+            }
+            last = a;
+            a = a->next;
+        }
+    }
+    if (last != nullptr) {
+        last->next = nullptr;
+    }
+    tail_ = last;
+    seal();
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::checkpoint_front() {
+    if constexpr (Checkpoint::kept) {
+        if (this->checkpoints_valid_ && ++this->front_run_ >= segment_length) {
+            this->front_checkpoints_.push_back(head_);
+            this->front_run_ = 0;
+        }
+    }
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::checkpoint_back() {
+    if constexpr (Checkpoint::kept) {
+        if (this->checkpoints_valid_ && ++this->back_run_ >= segment_length) {
+            this->back_checkpoints_.push_back(tail_);
+            this->back_run_ = 0;
+        }
+    }
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::uncheckpoint(Node* node) {
+    if constexpr (Checkpoint::kept) {
+        std::vector<Node*>& fronts = this->front_checkpoints_;
+        std::vector<Node*>& backs = this->back_checkpoints_;
+        if (!this->checkpoints_valid_) {
+            return;
+        }
+        if (!fronts.empty() && fronts.back() == node) {
+            fronts.pop_back();
+        } else if (!backs.empty() && backs.back() == node) {
+            backs.pop_back();
+        } else if (fronts.empty() && !backs.empty() && backs.front() == node) {
+            backs.erase(backs.begin());
+        } else if (backs.empty() && !fronts.empty() && fronts.front() == node) {
+            fronts.erase(fronts.begin());
+        } else if (node == head_) {
+            this->front_run_ = (this->front_run_ > 0) ? this->front_run_ - 1 : 0;
+        } else if (node == tail_) {
+            this->back_run_ = (this->back_run_ > 0) ? this->back_run_ - 1 : 0;
+        } else {
+            // O(size / segment_length), small next to the walk that found the node
+            typename std::vector<Node*>::iterator it = std::find(fronts.begin(), fronts.end(), node);
+            if (it != fronts.end()) {
+                fronts.erase(it);
+            } else {
+                it = std::find(backs.begin(), backs.end(), node);
+                if (it != backs.end()) {
+                    backs.erase(it);
+                }
+            }
+        }
+    }
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::invalidate_checkpoints() {
+    if constexpr (Checkpoint::kept) {
+        this->checkpoints_valid_ = false;
+    }
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::rebuild_checkpoints() const {
+    if constexpr (Checkpoint::kept) {
+        this->front_checkpoints_.clear();
+        this->back_checkpoints_.clear();
+        size_t index = 0;
+        for (Node* curr = head_; curr != nullptr; curr = next_of(curr)) {
+            if (index != 0 && index % segment_length == 0) {
+                this->back_checkpoints_.push_back(curr);
+            }
+            index++;
+        }
+        this->front_run_ = 0;
+        this->back_run_ = index % segment_length;
+        this->checkpoints_valid_ = true;
+    }
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+std::vector<typename list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::iterator> list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::segments() {
+    std::vector<iterator> starts;
+    if constexpr (Checkpoint::kept) {
+        this->checkpoints_valid_.ensure([this] { rebuild_checkpoints(); });
+        starts.reserve(this->front_checkpoints_.size() + this->back_checkpoints_.size() + 1);
+        if (head_ != nullptr) {
+            starts.push_back(iterator(head_, this));
+        }
+        for (size_t i = this->front_checkpoints_.size(); i > 0; i--) {
+            if (this->front_checkpoints_[i - 1] != head_) {
+                starts.push_back(iterator(this->front_checkpoints_[i - 1], this));
+            }
+        }
+        for (Node* checkpoint : this->back_checkpoints_) {
+            if (checkpoint != head_) {
+                starts.push_back(iterator(checkpoint, this));
+            }
+        }
+    } else {
+        // no checkpoints kept, find the cut points with one walk
+        size_t index = 0;
+        for (Node* curr = head_; curr != nullptr; curr = next_of(curr)) {
+            if (index % segment_length == 0) {
+                starts.push_back(iterator(curr, this));
+            }
+            index++;
+        }
+    }
+    return starts;
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+std::vector<typename list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::const_iterator> list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::segments() const {
+    std::vector<iterator> starts = const_cast<list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>*>(this)->segments();
+    return std::vector<const_iterator>(starts.begin(), starts.end());
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::summary_add(const T& val) {
+    if constexpr (is_summarizable<T>::value) {
+        if (summary_ && summary_valid_) {
+            if (this->counted() > 2 * summary_->expected()) {
+                summary_valid_ = false;                   // grown well past its sizing, rebuild it larger
+            } else {
+                summary_->insert(val);
+            }
+        }
+    }
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::summary_remove(const T& val) {
+    if constexpr (is_summarizable<T>::value) {
+        if (summary_ && summary_valid_) {
+            summary_->erase(val);
+        }
+    }
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+bool list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::summary_excludes(const T& val) const {
+    if constexpr (is_summarizable<T>::value) {
+        if (summary_) {
+            summary_valid_.ensure([this] { rebuild_summary(); });
+            return !summary_->possibly_contains(val);
+        }
+    }
+    return false;
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::rebuild_summary() const {
+    if (this->counted() > summary_->expected()) {
+        summary_->reserve(2 * this->counted());
+    } else {
+        summary_->clear();
+    }
+    for (Node* curr = head_; curr != nullptr; curr = next_of(curr)) {
+        summary_->insert(curr->val);
+    }
+    summary_valid_ = true;
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::enable_summary(size_t expected, double fp_rate, size_t max_bytes) {
+    static_assert(is_summarizable<T>::value, "enable_summary() needs std::hash of the element type");
+    static_assert(Size::tracked, "enable_summary() needs the tracked_size policy");
+    summary_.reset(new CountingBloomFilter<T>(std::max(expected, this->counted()), fp_rate, max_bytes));
+    rebuild_summary();
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::disable_summary() {
+    summary_.reset();
+    summary_valid_ = true;
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+size_t list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::summary_bytes() const {
+    return summary_ ? summary_->bytes() : 0;
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::set_reclaim_mode(reclaim_mode mode, size_t step) {
+    reclaim_mode_ = mode;
+    reclaim_step_ = (step == 0) ? 1 : step;
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::reclaim(size_t count) {
+    while (count != 0 && !garbage_.empty()) {
+        Node*& chain = garbage_.back();
+        Node* del_node = chain;
+        chain = chain->next;
+        free_node(del_node);
+        garbage_size_--;
+        count--;
+        if (chain == nullptr) {
+            garbage_.pop_back();
+        }
+    }
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+size_t list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::pending_reclaim() const {
+    return garbage_size_;
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::reclaim_some() {
+    if (!garbage_.empty()) {
+        reclaim(reclaim_step_);
+    }
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void* list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::dispose_chain(void* head, size_t count) {
+    Node* curr = static_cast<Node*>(head);
+    while (curr != nullptr && count != 0) {
+        Node* del_node = curr;
+        curr = curr->next;
+        delete del_node;
+        count--;
+    }
+    return curr;
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+size_t list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::size() const {
+    if constexpr (Size::tracked) {
+        return this->counted();
+    } else {
+        size_t count = 0;
+        for (const Node* curr = head_; curr != nullptr; curr = next_of(curr)) {
+            count++;
+        }
+        return count;
+    }
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+bool list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::empty() const {
+    return head_ == nullptr;
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+const Instrument& list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::stats() const {
+    return *this;
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::write_to(ElementWriter& out, const char* separator, const char* terminator) const {
+    out.put_range(begin(), end(), separator, terminator);
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::write_to(std::ostream& stream, const char* separator, const char* terminator) const {
+    ElementWriter out(stream);
+    write_to(out, separator, terminator);
+    out.write_out();                                      // here, not in the destructor, so a failed write throws
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::write_to(int fd, const char* separator, const char* terminator) const {
+    ElementWriter out(fd);
+    write_to(out, separator, terminator);
+    out.write_out();                                      // here, not in the destructor, so a failed write throws
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::print() const {
+    write_to(std::cout);
+    std::cout.flush();
+}
+
+template<class T, class Link, class Organize, class Alloc, class Size, class Instrument, class Checkpoint>
+void list<T, Link, Organize, Alloc, Size, Instrument, Checkpoint>::print_reverse() const {
+    static_assert(Link::backward, "print_reverse() needs the double_link policy");
+    ElementWriter out(std::cout);
+    out.put_range(std::make_reverse_iterator(end()), std::make_reverse_iterator(begin()), " ", "\n");
+    out.flush();
+}
+
+} // namespace list_core
@@ -0,0 +1,162 @@
+// file: ListViews.hpp
+
+#pragma once
+
+// Lazy views over the Linked lists (C++20).
+// The lists expose begin() / end(), so they are std::ranges::forward_range
+// (DoublyLinkedList is a bidirectional_range) and compose with the standard
+// adaptors. Adaptors never allocate nodes; a pipeline is evaluated element by
+// element when a terminal operation walks it, so the whole chain runs in one
+// traversal of the underlying list:
+//
+//     size_t n = list | list_view::filter(is_odd)
+//                     | list_view::transform(square)
+//                     | list_view::take(10)
+//                     | list_view::count();
+//
+// reverse needs a bidirectional range, so it only applies to DoublyLinkedList.
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace list_view {
+
+using std::views::filter;
+using std::views::transform;
+using std::views::take;
+using std::views::drop;
+using std::views::reverse;
+
+template<std::ranges::view R1, std::ranges::view R2>
+class zip_view : public std::ranges::view_interface<zip_view<R1, R2>> {
+    private:
+        R1 first_;
+        R2 second_;
+
+        class iterator;
+
+        class sentinel {
+            private:
+                std::ranges::sentinel_t<R1> end1_;
+                std::ranges::sentinel_t<R2> end2_;
+                friend class iterator;
+            public:
+                sentinel() = default;
+                sentinel(std::ranges::sentinel_t<R1> end1, std::ranges::sentinel_t<R2> end2) : end1_(end1), end2_(end2) {};
+        };
+
+        class iterator {
+            private:
+                std::ranges::iterator_t<R1> it1_;
+                std::ranges::iterator_t<R2> it2_;
+            public:
+                typedef std::pair<std::ranges::range_reference_t<R1>, std::ranges::range_reference_t<R2>> value_type;
+                typedef std::ptrdiff_t difference_type;
+
+                iterator() = default;
+                iterator(std::ranges::iterator_t<R1> it1, std::ranges::iterator_t<R2> it2) : it1_(it1), it2_(it2) {};
+
+                value_type operator*() const { return value_type(*it1_, *it2_); };
+                iterator& operator++() { ++it1_; ++it2_; return *this; };
+                void operator++(int) { ++*this; };
+
+                // stop at the end of the shorter range
+                bool operator==(const sentinel& s) const { return it1_ == s.end1_ || it2_ == s.end2_; };
+        };
+
+    public:
+        zip_view() = default;
+        zip_view(R1 first, R2 second) : first_(std::move(first)), second_(std::move(second)) {};
+
+        iterator begin() { return iterator(std::ranges::begin(first_), std::ranges::begin(second_)); };
+        sentinel end() { return sentinel(std::ranges::end(first_), std::ranges::end(second_)); };
+};
+
+template<class R1, class R2>
+zip_view(R1&&, R2&&) -> zip_view<std::views::all_t<R1>, std::views::all_t<R2>>;
+
+// zip(a, b) pairs up the elements of two ranges, stopping at the shorter one
+template<std::ranges::viewable_range R1, std::ranges::viewable_range R2>
+auto zip(R1&& first, R2&& second) {
+    return zip_view(std::forward<R1>(first), std::forward<R2>(second));
+}
+
+// Terminal operations, written as `range | list_view::count()`.
+// Each one walks the range once and drives the whole pipeline in that pass.
+template<class F>
+class terminal {
+    private:
+        F fn_;
+    public:
+        explicit terminal(F fn) : fn_(std::move(fn)) {};
+
+        template<std::ranges::input_range R>
+        friend decltype(auto) operator|(R&& range, const terminal& t) { return t.fn_(std::forward<R>(range)); };
+};
+
+inline auto count() {
+    return terminal([](auto&& range) {
+        size_t n = 0;
+        for (auto it = std::ranges::begin(range); it != std::ranges::end(range); ++it) {
+            n++;
+        }
+        return n;
+    });
+}
+
+template<class Fn>
+auto for_each(Fn fn) {
+    return terminal([fn](auto&& range) {
+        for (auto&& val : range) {
+            std::invoke(fn, std::forward<decltype(val)>(val));
+        }
+    });
+}
+
+template<class Init, class Op = std::plus<>>
+auto reduce(Init init, Op op = Op()) {
+    return terminal([init, op](auto&& range) {
+        Init acc = init;
+        for (auto&& val : range) {
+            acc = std::invoke(op, std::move(acc), std::forward<decltype(val)>(val));
+        }
+        return acc;
+    });
+}
+
+// Append the elements of the view to a List, e.g. `view | to_list(out)`.
+// Lists without back() have no O(1) push_back, so the new
+// elements are pushed at the front and the list is reversed once at the end;
+// out must be empty in that case.
+template<class List>
+auto to_list(List& out) {
+    return terminal([&out](auto&& range) -> List& {
+        for (auto&& val : range) {
+            if constexpr (requires(List& l) { l.back(); }) {
+                out.push_back(val);
+            } else {
+                out.push_front(val);
+            }
+        }
+        if constexpr (!requires(List& l) { l.back(); }) {
+            out.reverse();
+        }
+        return out;
+    });
+}
+
+// Build a new List from the view, e.g. `view | to_list<DoublyLinkedList<int>>()`.
+template<class List>
+auto to_list() {
+    return terminal([](auto&& range) {
+        List out;
+        range | to_list(out);
+        return out;
+    });
+}
+
+}
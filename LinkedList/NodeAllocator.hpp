@@ -0,0 +1,33 @@
+// file: NodeAllocator.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+// Allocation hook for list nodes.
+// Every node class forwards its operator new / delete to node_allocator<NodeT>,
+// so the allocator of a list can be swapped without touching the list:
+//
+//     template<class T, class L, class O, class A>
+//     struct node_allocator<list_core::node<T, L, O, A>> : cached_node_allocator<list_core::node<T, L, O, A>> {};
+//
+// The specialization has to be visible before the first node is allocated.
+// A single list_core::list type can instead take an Alloc policy such as
+// cached_allocator (NodeCache.hpp).
+template<class NodeT>
+struct node_allocator {
+    static void* allocate(size_t size) {
+        if (alignof(NodeT) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            return ::operator new(size, std::align_val_t(alignof(NodeT)));
+        }
+        return ::operator new(size);
+    };
+    static void deallocate(void* p, size_t) noexcept {
+        if (alignof(NodeT) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(p, std::align_val_t(alignof(NodeT)));
+        } else {
+            ::operator delete(p);
+        }
+    };
+};
@@ -0,0 +1,241 @@
+// file: NodeCache.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+#include "NodeAllocator.hpp"
+
+// Thread-caching allocator for fixed-size nodes.
+// Each thread keeps two magazines (stacks of up to magazine_size free nodes),
+// so almost every allocate / deallocate is a few instructions on thread-local
+// data. When both magazines run dry the thread trades an empty magazine for a
+// full one from a shared depot, and when both fill up it hands a full one over,
+// so a mutex is taken once per magazine_size operations at most.
+// A node may be freed on any thread: it simply goes into that thread's
+// magazine, and the depot carries the surplus back to the threads that
+// allocate, which is what keeps producer-consumer handoffs balanced.
+// Memory beyond depot_limit full magazines is returned to operator delete, and
+// a thread's magazines move to the depot when the thread exits.
+template<size_t Size>
+class NodeCache {
+    private:
+        static const size_t magazine_size = 64;           // nodes per magazine
+        static const size_t depot_limit = 256;            // full magazines kept by the depot
+
+        struct magazine {
+            magazine* next;                               // link in the depot stacks
+            size_t count;
+            void* slots[magazine_size];
+        };
+
+        struct depot {
+            std::mutex lock;
+            magazine* full;
+            magazine* empty;
+            size_t full_count;
+            depot() : full(nullptr), empty(nullptr), full_count(0) {};
+            ~depot();
+        };
+
+        struct thread_cache {
+            magazine* loaded;                             // allocate / deallocate work here
+            magazine* previous;                           // always completely full or empty
+            thread_cache();
+            ~thread_cache();
+        };
+
+        static depot& shared();
+        static int& state();                              // 0 unused, 1 live, 2 destroyed on this thread
+        static thread_cache* local();                     // nullptr once the thread's cache is gone
+        static void release(magazine*) noexcept;          // free the nodes of a magazine
+
+    public:
+        static void* allocate();                          // one node of Size bytes
+        static void deallocate(void*) noexcept;           // give a node back, from any thread
+        static void trim();                               // free the nodes held by the depot
+};
+
+// node_allocator policy backed by NodeCache
+template<class NodeT>
+struct cached_node_allocator {
+    static_assert(alignof(NodeT) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "over-aligned nodes are not cached");
+    static void* allocate(size_t) { return NodeCache<sizeof(NodeT)>::allocate(); };
+    static void deallocate(void* p, size_t) noexcept { NodeCache<sizeof(NodeT)>::deallocate(p); };
+};
+
+// Alloc policy of list_core::list backed by NodeCache, for one list type
+// without specializing node_allocator
+struct cached_allocator {
+    template<class NodeT>
+    static void* allocate(size_t size) { return cached_node_allocator<NodeT>::allocate(size); };
+    template<class NodeT>
+    static void deallocate(void* p, size_t size) noexcept { cached_node_allocator<NodeT>::deallocate(p, size); };
+};
+
+template<size_t Size>
+NodeCache<Size>::depot::~depot() {
+    while (full != nullptr) {
+        magazine* mag = full;
+        full = full->next;
+        release(mag);
+        delete mag;
+    }
+    while (empty != nullptr) {
+        magazine* mag = empty;
+        empty = empty->next;
+        delete mag;
+    }
+}
+
+template<size_t Size>
+NodeCache<Size>::thread_cache::thread_cache() {
+    loaded = new magazine();
+    previous = new magazine();
+    state() = 1;
+}
+
+template<size_t Size>
+NodeCache<Size>::thread_cache::~thread_cache() {
+    depot& d = shared();
+    magazine* mags[2] = { loaded, previous };
+    for (magazine* mag : mags) {
+        std::lock_guard<std::mutex> lock(d.lock);
+        if (mag->count == 0) {
+            mag->next = d.empty;
+            d.empty = mag;
+        } else if (d.full_count < depot_limit) {
+            mag->next = d.full;
+            d.full = mag;
+            d.full_count++;
+        } else {
+            release(mag);
+            delete mag;
+        }
+    }
+    state() = 2;
+}
+
+template<size_t Size>
+typename NodeCache<Size>::depot& NodeCache<Size>::shared() {
+    static depot d;
+    return d;
+}
+
+template<size_t Size>
+int& NodeCache<Size>::state() {
+    static thread_local int s = 0;
+    return s;
+}
+
+template<size_t Size>
+typename NodeCache<Size>::thread_cache* NodeCache<Size>::local() {
+    if (state() == 2) {
+        return nullptr;
+    }
+    shared();                                             // the depot must outlive the thread caches
+    static thread_local thread_cache cache;
+    return &cache;
+}
+
+template<size_t Size>
+void NodeCache<Size>::release(magazine* mag) noexcept {
+    for (size_t i = 0; i < mag->count; i++) {
+        ::operator delete(mag->slots[i]);
+    }
+    mag->count = 0;
+}
+
+template<size_t Size>
+void* NodeCache<Size>::allocate() {
+    thread_cache* c = local();
+    if (c == nullptr) {
+        return ::operator new(Size);
+    }
+    if (c->loaded->count == 0) {
+        if (c->previous->count != 0) {
+            std::swap(c->loaded, c->previous);
+        } else {
+            // trade the empty magazine for a full one from the depot
+            depot& d = shared();
+            std::lock_guard<std::mutex> lock(d.lock);
+            if (d.full == nullptr) {
+                return ::operator new(Size);
+            }
+            magazine* mag = d.full;
+            d.full = mag->next;
+            d.full_count--;
+            c->loaded->next = d.empty;
+            d.empty = c->loaded;
+            c->loaded = mag;
+        }
+    }
+    return c->loaded->slots[--c->loaded->count];
+}
+
+template<size_t Size>
+void NodeCache<Size>::deallocate(void* p) noexcept {
+    thread_cache* c = local();
+    if (c == nullptr) {
+        ::operator delete(p);
+        return;
+    }
+    if (c->loaded->count == magazine_size) {
+        if (c->previous->count != 0) {
+            // hand the full previous magazine to the depot for an empty one
+            depot& d = shared();
+            magazine* spare = nullptr;
+            bool room;
+            {
+                std::lock_guard<std::mutex> lock(d.lock);
+                room = d.full_count < depot_limit;
+                if (room && d.empty != nullptr) {
+                    spare = d.empty;
+                    d.empty = spare->next;
+                }
+            }
+            if (room && spare == nullptr) {
+                spare = new (std::nothrow) magazine();
+            }
+            if (spare == nullptr) {
+                release(c->previous);
+            } else {
+                std::lock_guard<std::mutex> lock(d.lock);
+                if (d.full_count < depot_limit) {         // other threads may have filled it since
+                    c->previous->next = d.full;
+                    d.full = c->previous;
+                    d.full_count++;
+                    c->previous = spare;
+                } else {
+                    release(c->previous);
+                    spare->next = d.empty;
+                    d.empty = spare;
+                }
+            }
+        }
+        std::swap(c->loaded, c->previous);
+    }
+    c->loaded->slots[c->loaded->count++] = p;
+}
+
+template<size_t Size>
+void NodeCache<Size>::trim() {
+    depot& d = shared();
+    magazine* full;
+    {
+        std::lock_guard<std::mutex> lock(d.lock);
+        full = d.full;
+        d.full = nullptr;
+        d.full_count = 0;
+    }
+    while (full != nullptr) {
+        magazine* mag = full;
+        full = full->next;
+        release(mag);
+        std::lock_guard<std::mutex> lock(d.lock);
+        mag->next = d.empty;
+        d.empty = mag;
+    }
+}
@@ -0,0 +1,104 @@
+// file: NodeHandle.hpp
+
+#pragma once
+
+#include <utility>
+
+// Owning handle to a node unlinked by extract(), like the node_type of the
+// C++17 std containers. push_front / push_back / insert taking a handle link
+// the node in again, into the same list or any other list with the same node
+// type, without allocating or copying the element. An empty handle is
+// ignored by them. A handle still holding its node when destroyed deletes it.
+// SinglyLinkedList and CircularLinkedList of one element type share a node type.
+//
+//     SinglyLinkedList<int>::node_type node = work.extract(3);
+//     node.value() += 1;
+//     done.push_back(std::move(node));
+
+namespace list_core {
+template<class, class, class, class, class, class, class> class list;
+}
+
+template<class T, class NodeT>
+class node_handle {
+    private:
+        NodeT* node_;
+
+        explicit node_handle(NodeT* node) : node_(node) {};
+        NodeT* release();                                 // give up the node without deleting it
+
+        template<class, class, class, class, class, class, class> friend class list_core::list;
+
+    public:
+        typedef T value_type;
+
+        node_handle();                                    // empty handle
+        ~node_handle();                                   // deletes the node if it still holds one
+        node_handle(const node_handle<T, NodeT>&) = delete;
+        node_handle<T, NodeT>& operator=(const node_handle<T, NodeT>&) = delete;
+        node_handle(node_handle<T, NodeT>&&) noexcept;    // takes over the node, the other becomes empty
+        node_handle<T, NodeT>& operator=(node_handle<T, NodeT>&&) noexcept; // move assignment, deletes the node held before
+        void swap(node_handle<T, NodeT>&) noexcept;
+
+        T& value() const;                                 // the element in the node, requires a non-empty handle
+        bool empty() const;
+        explicit operator bool() const;                   // true if it holds a node
+};
+
+template<class T, class NodeT>
+node_handle<T, NodeT>::node_handle() {
+    node_ = nullptr;
+}
+
+template<class T, class NodeT>
+node_handle<T, NodeT>::~node_handle() {
+    delete node_;
+}
+
+template<class T, class NodeT>
+node_handle<T, NodeT>::node_handle(node_handle<T, NodeT>&& other) noexcept {
+    node_ = other.node_;
+    other.node_ = nullptr;
+}
+
+template<class T, class NodeT>
+node_handle<T, NodeT>& node_handle<T, NodeT>::operator=(node_handle<T, NodeT>&& other) noexcept {
+    if (this != &other) {
+        delete node_;
+        node_ = other.node_;
+        other.node_ = nullptr;
+    }
+    return *this;
+}
+
+template<class T, class NodeT>
+void node_handle<T, NodeT>::swap(node_handle<T, NodeT>& other) noexcept {
+    std::swap(node_, other.node_);
+}
+
+template<class T, class NodeT>
+void swap(node_handle<T, NodeT>& a, node_handle<T, NodeT>& b) noexcept {
+    a.swap(b);
+}
+
+template<class T, class NodeT>
+NodeT* node_handle<T, NodeT>::release() {
+    NodeT* node = node_;
+    node_ = nullptr;
+    return node;
+}
+
+template<class T, class NodeT>
+T& node_handle<T, NodeT>::value() const {
+    return node_->val;
+}
+
+template<class T, class NodeT>
+bool node_handle<T, NodeT>::empty() const {
+    return node_ == nullptr;
+}
+
+template<class T, class NodeT>
+node_handle<T, NodeT>::operator bool() const {
+    return node_ != nullptr;
+}
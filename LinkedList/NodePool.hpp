@@ -0,0 +1,85 @@
+// file: NodePool.hpp
+
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Contiguous node storage for the Pool*LinkedList classes.
+// Nodes live in one growable std::vector and refer to each other through
+// 32-bit indices instead of pointers, so a list can be copied, moved or
+// written out byte for byte and its nodes stay close together in memory.
+// Released slots are chained through their `next` field and reused first.
+// A released slot is reset to NodeT() right away, so a value holding memory or
+// other resources (a string, a vector) gives them up when it leaves the list,
+// not when its slot is reused; for such values NodeT must be default
+// constructible. NodeT must have a `next` member of type uint32_t.
+template<class NodeT>
+class NodePool {
+    private:
+        std::vector<NodeT> nodes_;
+        uint32_t free_head_;
+
+    public:
+        static const uint32_t nil = UINT32_MAX;           // "null" index
+
+        NodePool() : free_head_(nil) {};
+
+        NodeT& operator[](uint32_t i) { return nodes_[i]; };
+        const NodeT& operator[](uint32_t i) const { return nodes_[i]; };
+
+        uint32_t allocate(const NodeT&);                  // store node and return its index
+        void release(uint32_t);                           // reset the slot and give it back to the free list
+        void clear();                                     // drop every node
+        void reserve(size_t);                             // reserve storage for n nodes
+
+        size_t capacity() const;                          // number of slots, used or free
+        size_t bytes() const;                             // bytes held by the pool
+};
+
+template<class NodeT>
+uint32_t NodePool<NodeT>::allocate(const NodeT& node) {
+    if (free_head_ != nil) {
+        uint32_t i = free_head_;
+        free_head_ = nodes_[i].next;
+        nodes_[i] = node;
+        return i;
+    }
+    if (nodes_.size() >= nil) {
+        throw std::overflow_error("the node pool is full");
+    }
+    nodes_.push_back(node);
+    return static_cast<uint32_t>(nodes_.size() - 1);
+}
+
+template<class NodeT>
+void NodePool<NodeT>::release(uint32_t i) {
+    if constexpr (!std::is_trivially_destructible<NodeT>::value) {
+        nodes_[i] = NodeT();                              // nothing to let go of for trivial values
+    }
+    nodes_[i].next = free_head_;
+    free_head_ = i;
+}
+
+template<class NodeT>
+void NodePool<NodeT>::clear() {
+    nodes_.clear();
+    free_head_ = nil;
+}
+
+template<class NodeT>
+void NodePool<NodeT>::reserve(size_t n) {
+    nodes_.reserve(n);
+}
+
+template<class NodeT>
+size_t NodePool<NodeT>::capacity() const {
+    return nodes_.size();
+}
+
+template<class NodeT>
+size_t NodePool<NodeT>::bytes() const {
+    return nodes_.capacity() * sizeof(NodeT);
+}
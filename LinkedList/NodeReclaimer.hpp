@@ -0,0 +1,123 @@
+// file: NodeReclaimer.hpp
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+// How a list frees its nodes on clear() and destruction:
+// reclaim_immediate deletes them right away on the calling thread,
+// reclaim_incremental detaches the chain in O(1) and frees a bounded number of
+// nodes at the start of every later push / insert / pop / remove (whatever is
+// left when the list is destroyed goes to the NodeReclaimer thread),
+// reclaim_background detaches the chain in O(1) and hands it to NodeReclaimer.
+enum reclaim_mode { reclaim_immediate, reclaim_incremental, reclaim_background };
+
+// Background thread that frees detached node chains.
+// A list in reclaim_background mode hands its whole chain over in O(1) from
+// clear() or its destructor; the chain is then deleted here in batches with a
+// yield in between, off the thread that dropped it. Chains retired while the process is shutting
+// down (after the reclaimer itself was destroyed) are freed on the spot.
+class NodeReclaimer {
+    private:
+        static const size_t batch_size = 1024;            // nodes freed between yields
+
+        struct chain {
+            void* head;
+            void* (*dispose)(void*, size_t);              // frees up to that many nodes from head on, returns the rest
+        };
+
+        std::deque<chain> queue_;
+        std::mutex mutex_;
+        std::condition_variable ready_;                   // a chain was queued or stop_ was set
+        std::condition_variable idle_;                    // the queue ran empty
+        bool busy_;                                       // the thread is freeing a chain
+        bool stop_;
+        std::thread thread_;
+
+        NodeReclaimer();
+        static bool& shut_down();                         // true once the instance is destroyed
+        void run();
+
+    public:
+        ~NodeReclaimer();                                 // frees every queued chain, then joins the thread
+
+        NodeReclaimer(const NodeReclaimer&) = delete;
+        NodeReclaimer& operator=(const NodeReclaimer&) = delete;
+
+        static NodeReclaimer& instance();
+        static void retire(void*, void* (*)(void*, size_t)); // queue a chain for the background thread
+        void drain();                                     // wait until every chain queued so far is freed
+};
+
+inline NodeReclaimer::NodeReclaimer() {
+    busy_ = false;
+    stop_ = false;
+    thread_ = std::thread(&NodeReclaimer::run, this);
+}
+
+inline NodeReclaimer::~NodeReclaimer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    ready_.notify_one();
+    thread_.join();
+    shut_down() = true;
+}
+
+inline bool& NodeReclaimer::shut_down() {
+    static bool done = false;
+    return done;
+}
+
+inline NodeReclaimer& NodeReclaimer::instance() {
+    static NodeReclaimer reclaimer;
+    return reclaimer;
+}
+
+inline void NodeReclaimer::retire(void* head, void* (*dispose)(void*, size_t)) {
+    if (head == nullptr) {
+        return;
+    }
+    if (shut_down()) {
+        dispose(head, size_t(-1));
+        return;
+    }
+    NodeReclaimer& r = instance();
+    {
+        std::lock_guard<std::mutex> lock(r.mutex_);
+        r.queue_.push_back(chain{head, dispose});
+    }
+    r.ready_.notify_one();
+}
+
+inline void NodeReclaimer::drain() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return queue_.empty() && !busy_; });
+}
+
+inline void NodeReclaimer::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        ready_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+        if (queue_.empty()) {
+            return;                                       // stop_ and nothing left
+        }
+        chain c = queue_.front();
+        queue_.pop_front();
+        busy_ = true;
+        lock.unlock();
+        while ((c.head = c.dispose(c.head, batch_size)) != nullptr) {
+            std::this_thread::yield();                    // let the threads doing real work in between
+        }
+        lock.lock();
+        busy_ = false;
+        if (queue_.empty()) {
+            idle_.notify_all();
+        }
+    }
+}
@@ -0,0 +1,100 @@
+// file: ParallelList.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+#include "../WorkStealing/TaskScheduler.hpp"
+
+// Parallel algorithms for the list_core lists: SinglyLinkedList,
+// DoublyLinkedList and CircularLinkedList.
+// The list is cut at the points returned by segments(). A list built with
+// segment_checkpoints keeps them up to date as it grows, so splitting costs
+// O(size / segment_length); the default lists find them with one walk on the
+// calling thread before the tasks start. Consecutive segments are grouped into
+// a few tasks per worker and run on a TaskScheduler.
+// The list must not be modified while an algorithm is running.
+
+namespace parallel_detail {
+
+// Split the list into [first, last) chunks of whole segments and call
+// task(chunk_index, first, last) for each of them on the scheduler.
+template<class List, class Task>
+size_t run_chunks(TaskScheduler& scheduler, List& list, Task task) {
+    auto starts = list.segments();
+    if (starts.empty()) {
+        return 0;
+    }
+    size_t wanted = scheduler.num_workers() * 4;
+    size_t stride = (starts.size() + wanted - 1) / wanted;
+    size_t chunks = (starts.size() + stride - 1) / stride;
+
+    TaskGroup group(scheduler);
+    for (size_t c = 0; c < chunks; c++) {
+        auto first = starts[c * stride];
+        auto last = ((c + 1) * stride < starts.size()) ? starts[(c + 1) * stride] : list.end();
+        group.run([&task, c, first, last] { task(c, first, last); });
+    }
+    group.wait();
+    return chunks;
+}
+
+}
+
+// Call fn on every element; fn may run concurrently on different elements.
+template<class List, class Fn>
+void parallel_for_each(TaskScheduler& scheduler, List& list, Fn fn) {
+    parallel_detail::run_chunks(scheduler, list, [&fn](size_t, auto first, auto last) {
+        for (auto it = first; it != last; ++it) {
+            fn(*it);
+        }
+    });
+}
+
+// Fold the elements with op, which must be associative; init is used once.
+template<class List, class R, class Op>
+R parallel_reduce(TaskScheduler& scheduler, const List& list, R init, Op op) {
+    std::vector<std::optional<R>> partials(scheduler.num_workers() * 4 + 1);
+    size_t chunks = parallel_detail::run_chunks(scheduler, list, [&partials, &op](size_t c, auto first, auto last) {
+        std::optional<R> acc;
+        for (auto it = first; it != last; ++it) {
+            if (acc) {
+                acc = op(std::move(*acc), *it);
+            } else {
+                acc = R(*it);
+            }
+        }
+        partials[c] = std::move(acc);
+    });
+
+    R result = std::move(init);
+    for (size_t c = 0; c < chunks; c++) {
+        if (partials[c]) {
+            result = op(std::move(result), std::move(*partials[c]));
+        }
+    }
+    return result;
+}
+
+// Count the elements for which pred returns true.
+template<class List, class Pred>
+size_t parallel_count_if(TaskScheduler& scheduler, const List& list, Pred pred) {
+    std::vector<size_t> partials(scheduler.num_workers() * 4 + 1, 0);
+    size_t chunks = parallel_detail::run_chunks(scheduler, list, [&partials, &pred](size_t c, auto first, auto last) {
+        size_t n = 0;
+        for (auto it = first; it != last; ++it) {
+            if (pred(*it)) {
+                n++;
+            }
+        }
+        partials[c] = n;
+    });
+
+    size_t count = 0;
+    for (size_t c = 0; c < chunks; c++) {
+        count += partials[c];
+    }
+    return count;
+}
@@ -0,0 +1,286 @@
+// file: PoolCircularLinkedList.hpp
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "KeySearch.hpp"
+#include "NodePool.hpp"
+
+// CircularLinkedList with its nodes in a NodePool, linked by 32-bit indices.
+// cursor_ is the back element, cursor_'s next is the front, as in CircularLinkedList.
+
+template<class T>
+struct PoolCircularNode {
+    T val;
+    uint32_t next;
+};
+
+template<class T>
+class PoolCircularLinkedList {
+    private:
+        typedef PoolCircularNode<T> node_type;
+        static const uint32_t nil = NodePool<node_type>::nil;
+
+        NodePool<node_type> pool_;
+        uint32_t cursor_;
+        size_t size_;
+
+        uint32_t before(size_t) const;                    // index of the node in front of position
+
+    public:
+        static const size_t npos = -1;
+
+        PoolCircularLinkedList();                         // constructor
+
+        T& front();                                       // return head element
+        T& back();
+        void clear();                                     // make the linked List to empty
+        void reserve(size_t);                             // reserve pool storage for n elements
+
+        void push_front(const T&);                        // insert element to front of Linked list
+        void push_front(const T&&);                       // overloading push_front()
+
+        void push_back(const T&);                         // insert element to end of Linked list
+        void push_back(const T&&);                        // overloading push_back()
+
+        void pop_front();                                 // remove the front element in Linked list
+
+        void pop_back();                                  // remove the end elemnt in Linked list
+
+        size_t find(const T&) const;                      // check the value is exit in the linked list and return the index
+        size_t find(const T&&) const;                     // overloading find()
+        std::vector<size_t> find_many(const T*, size_t) const; // index of each key in one walk, npos when absent
+
+        void insert(const T&, const size_t&);             // insert elements according to the index
+        void insert(const T&, const size_t&&);            // overloading insert()
+        void insert(const T&&, const size_t&);            // overloading insert()
+        void insert(const T&&, const size_t&&);           // overloading insert()
+
+        void remove(const size_t&);                       // remove element by index
+        void remove(const size_t&&);                      // overloading remove()
+
+        void advance();
+
+        size_t size() const;                              // return size of Linked list;
+        bool empty() const;                               // check the Linked list is empty
+        size_t memory_usage() const;                      // bytes held by the node pool
+        void print() const;
+};
+
+template<class T>
+uint32_t PoolCircularLinkedList<T>::before(size_t index) const {
+    uint32_t prev = cursor_;
+    for (size_t i = 0; i < index; i++) {
+        prev = pool_[prev].next;
+    }
+    return prev;
+}
+
+template<class T>
+PoolCircularLinkedList<T>::PoolCircularLinkedList() {
+    cursor_ = nil;
+    size_ = 0;
+}
+
+template<class T>
+T& PoolCircularLinkedList<T>::front() {
+    return pool_[pool_[cursor_].next].val;
+}
+
+template<class T>
+T& PoolCircularLinkedList<T>::back() {
+    return pool_[cursor_].val;
+}
+
+template<class T>
+void PoolCircularLinkedList<T>::clear() {
+    pool_.clear();
+    cursor_ = nil;
+    size_ = 0;
+}
+
+template<class T>
+void PoolCircularLinkedList<T>::reserve(size_t n) {
+    pool_.reserve(n);
+}
+
+template<class T>
+void PoolCircularLinkedList<T>::push_front(const T& val) {
+    if (cursor_ == nil) {
+        cursor_ = pool_.allocate(node_type{val, nil});
+        pool_[cursor_].next = cursor_;
+    } else {
+        uint32_t new_head = pool_.allocate(node_type{val, pool_[cursor_].next});
+        pool_[cursor_].next = new_head;
+    }
+    size_++;
+}
+
+template<class T>
+void PoolCircularLinkedList<T>::push_front(const T&& val) {
+    push_front(val);
+}
+
+template<class T>
+void PoolCircularLinkedList<T>::push_back(const T& val) {
+    push_front(val);
+    if (size_ > 1) {
+        cursor_ = pool_[cursor_].next;
+    }
+}
+
+template<class T>
+void PoolCircularLinkedList<T>::push_back(const T&& val) {
+    push_back(val);
+}
+
+template<class T>
+void PoolCircularLinkedList<T>::pop_front() {
+    if (cursor_ != nil) {
+        uint32_t head = pool_[cursor_].next;
+        if (head == cursor_) {
+            cursor_ = nil;
+        } else {
+            pool_[cursor_].next = pool_[head].next;
+        }
+        pool_.release(head);
+        size_--;
+    }
+}
+
+template<class T>
+void PoolCircularLinkedList<T>::pop_back() {
+    if (cursor_ != nil) {
+        if (size_ == 1) {
+            pop_front();
+        } else {
+            uint32_t new_cursor = before(size_ - 1);
+            pool_[new_cursor].next = pool_[cursor_].next;
+            pool_.release(cursor_);
+            cursor_ = new_cursor;
+            size_--;
+        }
+    }
+}
+
+template<class T>
+size_t PoolCircularLinkedList<T>::find(const T& val) const {
+    if (size_ != 0) {
+        uint32_t curr = pool_[cursor_].next;
+        for (size_t index = 0; index < size_; index++) {
+            if (pool_[curr].val == val) {
+                return index;
+            }
+            curr = pool_[curr].next;
+        }
+    }
+    return npos;
+}
+
+template<class T>
+size_t PoolCircularLinkedList<T>::find(const T&& val) const {
+    return find(val);
+}
+
+template<class T>
+std::vector<size_t> PoolCircularLinkedList<T>::find_many(const T* keys, size_t count) const {
+    KeySearch<T> search(keys, count);
+    if (size_ != 0) {
+        uint32_t curr = pool_[cursor_].next;
+        for (size_t index = 0; index < size_ && !search.done(); index++) {
+            search.add(pool_[curr].val);
+            curr = pool_[curr].next;
+        }
+    }
+    return search.positions();
+}
+
+template<class T>
+void PoolCircularLinkedList<T>::insert(const T& val, const size_t& index) {
+    if (index > size_) {
+        throw std::overflow_error("the index overflow error");
+    }
+
+    if (index == 0) {
+        push_front(val);
+    } else if (index == size_) {
+        push_back(val);
+    } else {
+        uint32_t prev = before(index);
+        uint32_t insert_node = pool_.allocate(node_type{val, pool_[prev].next});
+        pool_[prev].next = insert_node;
+        size_++;
+    }
+}
+
+template<class T>
+void PoolCircularLinkedList<T>::insert(const T& val, const size_t&& index) {
+    insert(val, index);
+}
+
+template<class T>
+void PoolCircularLinkedList<T>::insert(const T&& val, const size_t& index) {
+    insert(val, index);
+}
+
+template<class T>
+void PoolCircularLinkedList<T>::insert(const T&& val, const size_t&& index) {
+    insert(val, index);
+}
+
+template<class T>
+void PoolCircularLinkedList<T>::remove(const size_t& index) {
+    if (index >= size_) {
+        throw std::overflow_error("The index is overflow");
+    }
+
+    if (index == 0) {
+        pop_front();
+    } else if (index == size_ - 1) {
+        pop_back();
+    } else {
+        uint32_t prev = before(index);
+        uint32_t curr = pool_[prev].next;
+        pool_[prev].next = pool_[curr].next;
+        pool_.release(curr);
+        size_--;
+    }
+}
+
+template<class T>
+void PoolCircularLinkedList<T>::remove(const size_t&& index) {
+    remove(index);
+}
+
+template<class T>
+void PoolCircularLinkedList<T>::advance() {
+    cursor_ = pool_[cursor_].next;
+}
+
+template<class T>
+size_t PoolCircularLinkedList<T>::size() const {
+    return size_;
+}
+
+template<class T>
+bool PoolCircularLinkedList<T>::empty() const {
+    return size_ == 0;
+}
+
+template<class T>
+size_t PoolCircularLinkedList<T>::memory_usage() const {
+    return pool_.bytes();
+}
+
+template<class T>
+void PoolCircularLinkedList<T>::print() const {
+    uint32_t curr = pool_[cursor_].next;
+    while (curr != cursor_) {
+        std::cout << pool_[curr].val << " ";
+        curr = pool_[curr].next;
+    }
+    std::cout << pool_[cursor_].val << std::endl;
+}
@@ -0,0 +1,266 @@
+// file: PoolSinglyLinkedList.hpp
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "KeySearch.hpp"
+#include "NodePool.hpp"
+
+// SinglyLinkedList with its nodes in a NodePool, linked by 32-bit indices.
+// An int node takes 8 bytes instead of 16 plus the allocator header.
+
+template<class T>
+struct PoolSinglyNode {
+    T val;
+    uint32_t next;
+};
+
+template<class T>
+class PoolSinglyLinkedList {
+    private:
+        typedef PoolSinglyNode<T> node_type;
+        static const uint32_t nil = NodePool<node_type>::nil;
+
+        NodePool<node_type> pool_;
+        uint32_t head_;
+        uint32_t tail_;
+        size_t size_;
+
+    public:
+        static const size_t npos = -1;
+
+        PoolSinglyLinkedList();                           // constructor
+
+        T& front();                                       // return head element
+        void clear();                                     // make the linked List to empty
+        void reserve(size_t);                             // reserve pool storage for n elements
+
+        void push_front(const T&);                        // insert element to front of Linked list
+        void push_front(const T&&);                       // overloading push_front()
+
+        void push_back(const T&);                         // insert element to end of Linked list
+        void push_back(const T&&);                        // overloading push_back()
+
+        void pop_front();                                 // remove the front element in Linked list
+
+        void pop_back();                                  // remove the end elemnt in Linked list
+
+        size_t find(const T&) const;                      // check the value is exit in the linked list and return the index
+        size_t find(const T&&) const;                     // overloading find()
+        std::vector<size_t> find_many(const T*, size_t) const; // index of each key in one walk, npos when absent
+
+        void insert(const T&, const size_t&);             // insert elements according to the index
+        void insert(const T&, const size_t&&);            // overloading insert()
+        void insert(const T&&, const size_t&);            // overloading insert()
+        void insert(const T&&, const size_t&&);           // overloading insert()
+
+        void remove(const size_t&);                       // remove element by index
+        void remove(const size_t&&);                      // overloading remove()
+
+        size_t size() const;                              // return size of Linked list;
+        bool empty() const;                               // check the Linked list is empty
+        size_t memory_usage() const;                      // bytes held by the node pool
+        void print() const;                               // print the elements of Linked list from front to end
+};
+
+template<class T>
+PoolSinglyLinkedList<T>::PoolSinglyLinkedList() {
+    head_ = nil;
+    tail_ = nil;
+    size_ = 0;
+}
+
+template<class T>
+T& PoolSinglyLinkedList<T>::front() {
+    return pool_[head_].val;
+}
+
+template<class T>
+void PoolSinglyLinkedList<T>::clear() {
+    pool_.clear();
+    head_ = nil;
+    tail_ = nil;
+    size_ = 0;
+}
+
+template<class T>
+void PoolSinglyLinkedList<T>::reserve(size_t n) {
+    pool_.reserve(n);
+}
+
+template<class T>
+void PoolSinglyLinkedList<T>::push_front(const T& val) {
+    head_ = pool_.allocate(node_type{val, head_});
+    if (tail_ == nil) {
+        tail_ = head_;
+    }
+    size_++;
+}
+
+template<class T>
+void PoolSinglyLinkedList<T>::push_front(const T&& val) {
+    push_front(val);
+}
+
+template<class T>
+void PoolSinglyLinkedList<T>::push_back(const T& val) {
+    uint32_t new_tail = pool_.allocate(node_type{val, nil});
+    if (tail_ == nil) {
+        head_ = new_tail;
+    } else {
+        pool_[tail_].next = new_tail;
+    }
+    tail_ = new_tail;
+    size_++;
+}
+
+template<class T>
+void PoolSinglyLinkedList<T>::push_back(const T&& val) {
+    push_back(val);
+}
+
+template<class T>
+void PoolSinglyLinkedList<T>::pop_front() {
+    if (head_ != nil) {
+        uint32_t new_head = pool_[head_].next;
+        pool_.release(head_);
+        head_ = new_head;
+        if (head_ == nil) {
+            tail_ = nil;
+        }
+        size_--;
+    }
+}
+
+template<class T>
+void PoolSinglyLinkedList<T>::pop_back() {
+    if (head_ != nil) {
+        if (size_ == 1) {
+            pop_front();
+        } else {
+            uint32_t prev = head_;
+            while (pool_[prev].next != tail_) {
+                prev = pool_[prev].next;
+            }
+            pool_.release(tail_);
+            pool_[prev].next = nil;
+            tail_ = prev;
+            size_--;
+        }
+    }
+}
+
+template<class T>
+size_t PoolSinglyLinkedList<T>::find(const T& val) const {
+    size_t index = 0;
+    uint32_t curr = head_;
+    while (curr != nil && pool_[curr].val != val) {
+        curr = pool_[curr].next;
+        index++;
+    }
+    return (curr == nil) ? npos : index;
+}
+
+template<class T>
+size_t PoolSinglyLinkedList<T>::find(const T&& val) const {
+    return find(val);
+}
+
+template<class T>
+std::vector<size_t> PoolSinglyLinkedList<T>::find_many(const T* keys, size_t count) const {
+    KeySearch<T> search(keys, count);
+    for (uint32_t curr = head_; curr != nil && !search.done(); curr = pool_[curr].next) {
+        search.add(pool_[curr].val);
+    }
+    return search.positions();
+}
+
+template<class T>
+void PoolSinglyLinkedList<T>::insert(const T& val, const size_t& index) {
+    if (index > size_) {
+        throw std::overflow_error("the index overflow error");
+    }
+    if (index == 0) {
+        push_front(val);
+    } else if (index == size_) {
+        push_back(val);
+    } else {
+        uint32_t prev = head_;
+        for (size_t i = 1; i < index; i++) {
+            prev = pool_[prev].next;
+        }
+        uint32_t insert_node = pool_.allocate(node_type{val, pool_[prev].next});
+        pool_[prev].next = insert_node;
+        size_++;
+    }
+}
+
+template<class T>
+void PoolSinglyLinkedList<T>::insert(const T& val, const size_t&& index) {
+    insert(val, index);
+}
+
+template<class T>
+void PoolSinglyLinkedList<T>::insert(const T&& val, const size_t& index) {
+    insert(val, index);
+}
+
+template<class T>
+void PoolSinglyLinkedList<T>::insert(const T&& val, const size_t&& index) {
+    insert(val, index);
+}
+
+template<class T>
+void PoolSinglyLinkedList<T>::remove(const size_t& index) {
+    if (index >= size_) {
+        throw std::overflow_error("The index is overflow");
+    }
+
+    if (index == 0) {
+        pop_front();
+    } else if (index == size_ - 1) {
+        pop_back();
+    } else {
+        uint32_t prev = head_;
+        for (size_t i = 1; i < index; i++) {
+            prev = pool_[prev].next;
+        }
+        uint32_t curr = pool_[prev].next;
+        pool_[prev].next = pool_[curr].next;
+        pool_.release(curr);
+        size_--;
+    }
+}
+
+template<class T>
+void PoolSinglyLinkedList<T>::remove(const size_t&& index) {
+    remove(index);
+}
+
+template<class T>
+size_t PoolSinglyLinkedList<T>::size() const {
+    return size_;
+}
+
+template<class T>
+bool PoolSinglyLinkedList<T>::empty() const {
+    return size_ == 0;
+}
+
+template<class T>
+size_t PoolSinglyLinkedList<T>::memory_usage() const {
+    return pool_.bytes();
+}
+
+template<class T>
+void PoolSinglyLinkedList<T>::print() const {
+    uint32_t curr = head_;
+    while (curr != nil) {
+        std::cout << pool_[curr].val << ' ';
+        curr = pool_[curr].next;
+    }
+    std::cout << std::endl;
+}
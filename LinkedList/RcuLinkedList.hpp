@@ -0,0 +1,451 @@
+// file: RcuLinkedList.hpp
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "NodeAllocator.hpp"
+
+// Read-mostly concurrent list in the style of RCU.
+// Readers go through a per-thread RcuLinkedList<T>::reader: entering a read
+// section stores the current epoch into the reader's own cache line, and the
+// traversal itself is plain acquire loads, so readers never execute an atomic
+// read-modify-write or write a shared line.
+// Writers are serialized by a mutex. They build the new node off to the side
+// and publish it with one release store of a next pointer; unlinked nodes keep
+// their next pointer, so a reader standing on one can still walk on. Unlinked
+// nodes are retired with the epoch they were removed in and freed once every
+// active reader has entered a later epoch.
+// All readers must be destroyed before the list.
+
+template<class T> class RcuLinkedList;
+
+template<class T>
+class RcuNode {
+    private:
+        T val;
+        std::atomic<RcuNode<T>*> next;
+    public:
+        RcuNode(const T& _val, RcuNode<T>* n) : val(_val), next(n) {};
+        static void* operator new(size_t size) { return node_allocator<RcuNode<T>>::allocate(size); };
+        static void operator delete(void* p, size_t size) { node_allocator<RcuNode<T>>::deallocate(p, size); };
+        friend class RcuLinkedList<T>;
+};
+
+template<class T>
+class RcuLinkedList {
+    private:
+        struct alignas(64) reader_slot {
+            std::atomic<uint64_t> epoch;                  // epoch of the open read section, 0 when outside
+            bool in_use;                                  // guarded by writer_
+            reader_slot() : epoch(0), in_use(false) {};
+        };
+
+        std::atomic<RcuNode<T>*> head_;
+        RcuNode<T>* tail_;                                // writer side only
+        std::atomic<size_t> size_;
+
+        std::mutex writer_;                               // serializes writers and reader registration
+        alignas(64) std::atomic<uint64_t> epoch_;
+        std::vector<std::unique_ptr<reader_slot>> slots_;
+        std::vector<std::pair<uint64_t, RcuNode<T>*>> retired_; // unlinked nodes and the epoch they left in
+
+        RcuNode<T>* before(size_t) const;                 // node in front of position, writer side
+        void retire(RcuNode<T>*);                         // hand an unlinked node to the reclaimer
+        void reclaim();                                   // free the retired nodes no reader can reach
+
+    public:
+        static const size_t npos = -1;
+
+        class reader {                                    // read side of one thread, not shared between threads
+            private:
+                RcuLinkedList<T>* list_;
+                reader_slot* slot_;
+                size_t depth_;                            // nesting of lock()
+            public:
+                explicit reader(RcuLinkedList<T>&);
+                ~reader();
+                reader(const reader&) = delete;
+                reader& operator=(const reader&) = delete;
+
+                void lock();                              // enter a read section
+                void unlock();                            // leave the read section
+
+                size_t find(const T&);                    // index of the value, npos when absent
+                bool contains(const T&);                  // check the value is in the list
+                template<class Fn>
+                void for_each(Fn);                        // call fn on every element inside one read section
+                size_t size() const;                      // size at the time of the call
+        };
+
+        RcuLinkedList();                                  // constructor
+        ~RcuLinkedList();                                 // destructor
+        RcuLinkedList(const RcuLinkedList<T>&) = delete;
+        RcuLinkedList<T>& operator=(const RcuLinkedList<T>&) = delete;
+
+        void clear();                                     // make the linked List to empty
+
+        void push_front(const T&);                        // insert element to front of Linked list
+        void push_front(const T&&);                       // overloading push_front()
+
+        void push_back(const T&);                         // insert element to end of Linked list
+        void push_back(const T&&);                        // overloading push_back()
+
+        void pop_front();                                 // remove the front element in Linked list
+
+        void insert(const T&, const size_t&);             // insert elements according to the index
+        void insert(const T&&, const size_t&);            // overloading insert()
+
+        void replace(const T&, const size_t&);            // swap in a new node holding the value at the index
+
+        void remove(const size_t&);                       // remove element by index
+        size_t remove_value(const T&);                    // remove every element equal to the value, return the count
+
+        void synchronize();                               // wait until every retired node is freed
+
+        size_t size() const;                              // return size of Linked list;
+        bool empty() const;                               // check the Linked list is empty
+        void print();                                     // print the elements of Linked list from front to end
+};
+
+template<class T>
+RcuLinkedList<T>::reader::reader(RcuLinkedList<T>& list) : list_(&list), slot_(nullptr), depth_(0) {
+    std::lock_guard<std::mutex> lock(list_->writer_);
+    for (auto& slot : list_->slots_) {
+        if (!slot->in_use) {
+            slot_ = slot.get();
+            break;
+        }
+    }
+    if (slot_ == nullptr) {
+        list_->slots_.emplace_back(new reader_slot());
+        slot_ = list_->slots_.back().get();
+    }
+    slot_->in_use = true;
+}
+
+template<class T>
+RcuLinkedList<T>::reader::~reader() {
+    slot_->epoch.store(0, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(list_->writer_);
+    slot_->in_use = false;
+}
+
+template<class T>
+void RcuLinkedList<T>::reader::lock() {
+    if (depth_++ == 0) {
+        // acquire, so an epoch past a retire() also shows the unlink made
+        // before it; a newer epoch with stale links would let reclaim() free
+        // a node the section can still reach
+        slot_->epoch.store(list_->epoch_.load(std::memory_order_acquire), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+template<class T>
+void RcuLinkedList<T>::reader::unlock() {
+    if (--depth_ == 0) {
+        slot_->epoch.store(0, std::memory_order_release);
+    }
+}
+
+template<class T>
+size_t RcuLinkedList<T>::reader::find(const T& val) {
+    lock();
+    size_t index = 0;
+    RcuNode<T>* curr = list_->head_.load(std::memory_order_acquire);
+    while (curr != nullptr && curr->val != val) {
+        curr = curr->next.load(std::memory_order_acquire);
+        index++;
+    }
+    unlock();
+    return (curr == nullptr) ? npos : index;
+}
+
+template<class T>
+bool RcuLinkedList<T>::reader::contains(const T& val) {
+    return find(val) != npos;
+}
+
+template<class T>
+template<class Fn>
+void RcuLinkedList<T>::reader::for_each(Fn fn) {
+    lock();
+    try {
+        for (RcuNode<T>* curr = list_->head_.load(std::memory_order_acquire); curr != nullptr;
+             curr = curr->next.load(std::memory_order_acquire)) {
+            fn(static_cast<const T&>(curr->val));
+        }
+    } catch (...) {
+        unlock();
+        throw;
+    }
+    unlock();
+}
+
+template<class T>
+size_t RcuLinkedList<T>::reader::size() const {
+    return list_->size_.load(std::memory_order_relaxed);
+}
+
+template<class T>
+RcuLinkedList<T>::RcuLinkedList() : head_(nullptr), size_(0), epoch_(1) {
+    tail_ = nullptr;
+}
+
+template<class T>
+RcuLinkedList<T>::~RcuLinkedList() {
+    RcuNode<T>* curr = head_.load(std::memory_order_relaxed);
+    while (curr != nullptr) {
+        RcuNode<T>* del_node = curr;
+        curr = curr->next.load(std::memory_order_relaxed);
+        delete del_node;
+    }
+    for (auto& r : retired_) {
+        delete r.second;
+    }
+}
+
+template<class T>
+RcuNode<T>* RcuLinkedList<T>::before(size_t index) const {
+    RcuNode<T>* prev = head_.load(std::memory_order_relaxed);
+    for (size_t i = 1; i < index; i++) {
+        prev = prev->next.load(std::memory_order_relaxed);
+    }
+    return prev;
+}
+
+template<class T>
+void RcuLinkedList<T>::retire(RcuNode<T>* node) {
+    retired_.emplace_back(epoch_.fetch_add(1, std::memory_order_seq_cst), node);
+}
+
+template<class T>
+void RcuLinkedList<T>::reclaim() {
+    if (retired_.empty()) {
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint64_t oldest = UINT64_MAX;
+    for (auto& slot : slots_) {
+        uint64_t e = slot->epoch.load(std::memory_order_seq_cst);
+        if (e != 0 && e < oldest) {
+            oldest = e;
+        }
+    }
+    size_t kept = 0;
+    for (size_t i = 0; i < retired_.size(); i++) {
+        if (retired_[i].first < oldest) {
+            delete retired_[i].second;
+        } else {
+            retired_[kept++] = retired_[i];
+        }
+    }
+    retired_.resize(kept);
+}
+
+template<class T>
+void RcuLinkedList<T>::clear() {
+    std::lock_guard<std::mutex> lock(writer_);
+    RcuNode<T>* curr = head_.load(std::memory_order_relaxed);
+    head_.store(nullptr, std::memory_order_release);
+    tail_ = nullptr;
+    size_.store(0, std::memory_order_relaxed);
+    // readers may still be anywhere on the old chain, retire it as a whole
+    while (curr != nullptr) {
+        RcuNode<T>* next = curr->next.load(std::memory_order_relaxed);
+        retire(curr);
+        curr = next;
+    }
+    reclaim();
+}
+
+template<class T>
+void RcuLinkedList<T>::push_front(const T& val) {
+    std::lock_guard<std::mutex> lock(writer_);
+    RcuNode<T>* new_head = new RcuNode<T>(val, head_.load(std::memory_order_relaxed));
+    head_.store(new_head, std::memory_order_release);
+    if (tail_ == nullptr) {
+        tail_ = new_head;
+    }
+    size_.store(size_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+template<class T>
+void RcuLinkedList<T>::push_front(const T&& val) {
+    push_front(val);
+}
+
+template<class T>
+void RcuLinkedList<T>::push_back(const T& val) {
+    std::lock_guard<std::mutex> lock(writer_);
+    RcuNode<T>* new_tail = new RcuNode<T>(val, nullptr);
+    if (tail_ == nullptr) {
+        head_.store(new_tail, std::memory_order_release);
+    } else {
+        tail_->next.store(new_tail, std::memory_order_release);
+    }
+    tail_ = new_tail;
+    size_.store(size_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+template<class T>
+void RcuLinkedList<T>::push_back(const T&& val) {
+    push_back(val);
+}
+
+template<class T>
+void RcuLinkedList<T>::pop_front() {
+    std::lock_guard<std::mutex> lock(writer_);
+    RcuNode<T>* head = head_.load(std::memory_order_relaxed);
+    if (head != nullptr) {
+        head_.store(head->next.load(std::memory_order_relaxed), std::memory_order_release);
+        if (tail_ == head) {
+            tail_ = nullptr;
+        }
+        size_.store(size_.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+        retire(head);
+        reclaim();
+    }
+}
+
+template<class T>
+void RcuLinkedList<T>::insert(const T& val, const size_t& index) {
+    std::lock_guard<std::mutex> lock(writer_);
+    size_t size = size_.load(std::memory_order_relaxed);
+    if (index > size) {
+        throw std::overflow_error("the index overflow error");
+    }
+    RcuNode<T>* prev = (index == 0) ? nullptr : before(index);
+    RcuNode<T>* next = (prev == nullptr) ? head_.load(std::memory_order_relaxed) : prev->next.load(std::memory_order_relaxed);
+    RcuNode<T>* insert_node = new RcuNode<T>(val, next);
+    if (prev == nullptr) {
+        head_.store(insert_node, std::memory_order_release);
+    } else {
+        prev->next.store(insert_node, std::memory_order_release);
+    }
+    if (tail_ == prev) {
+        tail_ = insert_node;
+    }
+    size_.store(size + 1, std::memory_order_relaxed);
+}
+
+template<class T>
+void RcuLinkedList<T>::insert(const T&& val, const size_t& index) {
+    insert(val, index);
+}
+
+template<class T>
+void RcuLinkedList<T>::replace(const T& val, const size_t& index) {
+    std::lock_guard<std::mutex> lock(writer_);
+    if (index >= size_.load(std::memory_order_relaxed)) {
+        throw std::overflow_error("The index is overflow");
+    }
+    RcuNode<T>* prev = (index == 0) ? nullptr : before(index);
+    RcuNode<T>* curr = (prev == nullptr) ? head_.load(std::memory_order_relaxed) : prev->next.load(std::memory_order_relaxed);
+    RcuNode<T>* new_node = new RcuNode<T>(val, curr->next.load(std::memory_order_relaxed));
+    if (prev == nullptr) {
+        head_.store(new_node, std::memory_order_release);
+    } else {
+        prev->next.store(new_node, std::memory_order_release);
+    }
+    if (tail_ == curr) {
+        tail_ = new_node;
+    }
+    retire(curr);
+    reclaim();
+}
+
+template<class T>
+void RcuLinkedList<T>::remove(const size_t& index) {
+    std::lock_guard<std::mutex> lock(writer_);
+    size_t size = size_.load(std::memory_order_relaxed);
+    if (index >= size) {
+        throw std::overflow_error("The index is overflow");
+    }
+    RcuNode<T>* prev = (index == 0) ? nullptr : before(index);
+    RcuNode<T>* curr = (prev == nullptr) ? head_.load(std::memory_order_relaxed) : prev->next.load(std::memory_order_relaxed);
+    RcuNode<T>* next = curr->next.load(std::memory_order_relaxed);
+    if (prev == nullptr) {
+        head_.store(next, std::memory_order_release);
+    } else {
+        prev->next.store(next, std::memory_order_release);
+    }
+    if (tail_ == curr) {
+        tail_ = prev;
+    }
+    size_.store(size - 1, std::memory_order_relaxed);
+    retire(curr);
+    reclaim();
+}
+
+template<class T>
+size_t RcuLinkedList<T>::remove_value(const T& val) {
+    std::lock_guard<std::mutex> lock(writer_);
+    size_t count = 0;
+    RcuNode<T>* prev = nullptr;
+    RcuNode<T>* curr = head_.load(std::memory_order_relaxed);
+    while (curr != nullptr) {
+        RcuNode<T>* next = curr->next.load(std::memory_order_relaxed);
+        if (curr->val == val) {
+            if (prev == nullptr) {
+                head_.store(next, std::memory_order_release);
+            } else {
+                prev->next.store(next, std::memory_order_release);
+            }
+            if (tail_ == curr) {
+                tail_ = prev;
+            }
+            retire(curr);
+            count++;
+        } else {
+            prev = curr;
+        }
+        curr = next;
+    }
+    if (count != 0) {
+        size_.store(size_.load(std::memory_order_relaxed) - count, std::memory_order_relaxed);
+        reclaim();
+    }
+    return count;
+}
+
+template<class T>
+void RcuLinkedList<T>::synchronize() {
+    std::unique_lock<std::mutex> lock(writer_);
+    reclaim();
+    while (!retired_.empty()) {
+        lock.unlock();
+        std::this_thread::yield();
+        lock.lock();
+        reclaim();
+    }
+}
+
+template<class T>
+size_t RcuLinkedList<T>::size() const {
+    return size_.load(std::memory_order_relaxed);
+}
+
+template<class T>
+bool RcuLinkedList<T>::empty() const {
+    return size() == 0;
+}
+
+template<class T>
+void RcuLinkedList<T>::print() {
+    std::lock_guard<std::mutex> lock(writer_);
+    for (RcuNode<T>* curr = head_.load(std::memory_order_relaxed); curr != nullptr;
+         curr = curr->next.load(std::memory_order_relaxed)) {
+        std::cout << curr->val << ' ';
+    }
+    std::cout << std::endl;
+}
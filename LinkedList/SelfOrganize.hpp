@@ -0,0 +1,36 @@
+// file: SelfOrganize.hpp
+
+#pragma once
+
+#include <cstdint>
+
+// Reordering policies for the Organize parameter of list_core::list, and so of
+// SinglyLinkedList, DoublyLinkedList and CircularLinkedList. A successful
+// find() on a non-const list moves the node it found, relinking it in the same
+// walk that found it; find() on a const list never reorders. find() returns
+// the index the value had before the move. node_base is mixed into every node,
+// so the policies without per-node state cost nothing.
+
+struct static_order {                                     // never reorder, the default
+    struct node_base {};
+};
+
+struct move_to_front_order {                              // move the found node to the front
+    struct node_base {};
+};
+
+struct transpose_order {                                  // swap the found node with its predecessor
+    struct node_base {};
+};
+
+// count_order keeps the list ordered by hits only while nodes are added at the
+// back (push_back(), or insert() at size()), where a node with no hits belongs.
+// push_front() and insert() elsewhere put a node with no hits where they are
+// told, possibly in front of nodes with more hits; find() only moves a node to
+// the front of the run of nodes sharing its old count, so it does not restore
+// the order across such a node.
+struct count_order {                                      // keep the nodes ordered by find() hits, most first
+    struct node_base {
+        uint32_t hits = 0;
+    };
+};
@@ -0,0 +1,406 @@
+// file: StaticDoublyList.hpp
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include "StaticListPolicy.hpp"
+
+// DoublyLinkedList with room for N elements inside the object and no heap use.
+// Nodes live in a std::array and are linked by the smallest index type that
+// fits N; released slots are chained through next into a free list.
+// Everything except print() / print_reverse() is constexpr.
+// T must be default constructible.
+
+template<class T, class I>
+struct StaticDoublyNode {
+    T val;
+    I prev;
+    I next;
+};
+
+template<class T, size_t N, class Overflow = throw_on_overflow>
+class StaticDoublyList {
+    private:
+        typedef typename static_list_index<N>::type index_type;
+        typedef StaticDoublyNode<T, index_type> node_type;
+        static constexpr index_type nil = index_type(-1);
+
+        std::array<node_type, N> nodes_;
+        index_type head_;
+        index_type tail_;
+        index_type free_head_;                            // released slots
+        index_type used_;                                 // slots handed out at least once
+        size_t size_;
+
+        constexpr index_type allocate(const T&, index_type, index_type); // take a slot, nil when full
+        constexpr void release(index_type);               // give the slot back to the free list
+        constexpr index_type at(size_t) const;            // slot at position, walking from the nearer end
+
+    public:
+        static constexpr size_t npos = -1;
+
+        template<class U>
+        class basic_iterator {                            // bidirectional iterator, U is T or const T
+            private:
+                typedef typename std::conditional<std::is_const<U>::value, const StaticDoublyList, StaticDoublyList>::type list_type;
+                list_type* list_;
+                index_type index_;
+                template<class> friend class basic_iterator;
+            public:
+                typedef std::bidirectional_iterator_tag iterator_category;
+                typedef T value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef U* pointer;
+                typedef U& reference;
+
+                constexpr basic_iterator() : list_(nullptr), index_(nil) {};
+                constexpr basic_iterator(list_type* list, index_type index) : list_(list), index_(index) {};
+                constexpr basic_iterator(const basic_iterator<T>& other) : list_(other.list_), index_(other.index_) {};
+
+                constexpr reference operator*() const { return list_->nodes_[index_].val; };
+                constexpr pointer operator->() const { return &list_->nodes_[index_].val; };
+                constexpr basic_iterator& operator++() { index_ = list_->nodes_[index_].next; return *this; };
+                constexpr basic_iterator operator++(int) { basic_iterator old = *this; ++*this; return old; };
+                constexpr basic_iterator& operator--() { index_ = (index_ == nil) ? list_->tail_ : list_->nodes_[index_].prev; return *this; };
+                constexpr basic_iterator operator--(int) { basic_iterator old = *this; --*this; return old; };
+                constexpr bool operator==(const basic_iterator& other) const { return index_ == other.index_; };
+                constexpr bool operator!=(const basic_iterator& other) const { return index_ != other.index_; };
+        };
+        typedef basic_iterator<T> iterator;
+        typedef basic_iterator<const T> const_iterator;
+
+        constexpr StaticDoublyList();                     // constructor
+
+        constexpr T& front();                             // return head element
+        constexpr const T& front() const;                 // overloading front()
+        constexpr T& back();                              // return tail element
+        constexpr const T& back() const;                  // overloading back()
+        constexpr void clear();                           // make the linked List to empty
+
+        constexpr iterator begin();                       // iterator to the front element
+        constexpr iterator end();                         // iterator past the last element
+        constexpr const_iterator begin() const;           // overloading begin()
+        constexpr const_iterator end() const;             // overloading end()
+
+        constexpr bool push_front(const T&);              // insert element to front of Linked list, false when full
+        constexpr bool push_front(const T&&);             // overloading push_front()
+
+        constexpr bool push_back(const T&);               // insert element to end of Linked list, false when full
+        constexpr bool push_back(const T&&);              // overloading push_back()
+
+        constexpr void pop_front();                       // remove the front element in Linked list
+
+        constexpr void pop_back();                        // remove the end elemnt in Linked list
+
+        constexpr size_t find(const T&) const;            // check the value is exit in the linked list and return the index
+        constexpr size_t find(const T&&) const;           // overloading find()
+
+        constexpr bool insert(const T&, const size_t&);   // insert elements according to the index, false when full
+        constexpr bool insert(const T&, const size_t&&);  // overloading insert()
+        constexpr bool insert(const T&&, const size_t&);  // overloading insert()
+        constexpr bool insert(const T&&, const size_t&&); // overloading insert()
+
+        constexpr void remove(const size_t&);             // remove element by index
+        constexpr void remove(const size_t&&);            // overloading remove()
+        constexpr size_t remove_value(const T&);          // remove every element equal to the value in one pass, return the count
+        template<class Pred>
+        constexpr size_t remove_if(Pred);                 // remove every element matching pred in one pass, return the count
+
+        constexpr void reverse();                         // reverse the Linkde list
+
+        constexpr size_t size() const;                    // return size of Linked list;
+        constexpr size_t capacity() const;                // maximum number of elements
+        constexpr bool empty() const;                     // check the Linked list is empty
+        constexpr bool full() const;                      // check the Linked list has no free slot
+        void print() const;                               // print the elements of Linked list from front to end
+        void print_reverse() const;                       // print the elements of Linked list from end to front
+};
+
+template<class T, size_t N, class Overflow>
+constexpr typename StaticDoublyList<T, N, Overflow>::index_type StaticDoublyList<T, N, Overflow>::allocate(const T& val, index_type prev, index_type next) {
+    index_type i = nil;
+    if (free_head_ != nil) {
+        i = free_head_;
+        free_head_ = nodes_[i].next;
+    } else if (used_ < N) {
+        i = used_++;
+    } else {
+        return nil;
+    }
+    nodes_[i].val = val;
+    nodes_[i].prev = prev;
+    nodes_[i].next = next;
+    if (prev == nil) {
+        head_ = i;
+    } else {
+        nodes_[prev].next = i;
+    }
+    if (next == nil) {
+        tail_ = i;
+    } else {
+        nodes_[next].prev = i;
+    }
+    size_++;
+    return i;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr void StaticDoublyList<T, N, Overflow>::release(index_type i) {
+    index_type prev = nodes_[i].prev;
+    index_type next = nodes_[i].next;
+    if (prev == nil) {
+        head_ = next;
+    } else {
+        nodes_[prev].next = next;
+    }
+    if (next == nil) {
+        tail_ = prev;
+    } else {
+        nodes_[next].prev = prev;
+    }
+    nodes_[i].next = free_head_;
+    free_head_ = i;
+    size_--;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr typename StaticDoublyList<T, N, Overflow>::index_type StaticDoublyList<T, N, Overflow>::at(size_t index) const {
+    index_type curr = nil;
+    if (index > size_ / 2) {
+        curr = tail_;
+        for (size_t i = size_ - 1; i > index; i--) {
+            curr = nodes_[curr].prev;
+        }
+    } else {
+        curr = head_;
+        for (size_t i = 0; i < index; i++) {
+            curr = nodes_[curr].next;
+        }
+    }
+    return curr;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr StaticDoublyList<T, N, Overflow>::StaticDoublyList() : nodes_(), head_(nil), tail_(nil), free_head_(nil), used_(0), size_(0) {}
+
+template<class T, size_t N, class Overflow>
+constexpr T& StaticDoublyList<T, N, Overflow>::front() {
+    return nodes_[head_].val;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr const T& StaticDoublyList<T, N, Overflow>::front() const {
+    return nodes_[head_].val;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr T& StaticDoublyList<T, N, Overflow>::back() {
+    return nodes_[tail_].val;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr const T& StaticDoublyList<T, N, Overflow>::back() const {
+    return nodes_[tail_].val;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr void StaticDoublyList<T, N, Overflow>::clear() {
+    head_ = nil;
+    tail_ = nil;
+    free_head_ = nil;
+    used_ = 0;
+    size_ = 0;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr typename StaticDoublyList<T, N, Overflow>::iterator StaticDoublyList<T, N, Overflow>::begin() {
+    return iterator(this, head_);
+}
+
+template<class T, size_t N, class Overflow>
+constexpr typename StaticDoublyList<T, N, Overflow>::iterator StaticDoublyList<T, N, Overflow>::end() {
+    return iterator(this, nil);
+}
+
+template<class T, size_t N, class Overflow>
+constexpr typename StaticDoublyList<T, N, Overflow>::const_iterator StaticDoublyList<T, N, Overflow>::begin() const {
+    return const_iterator(this, head_);
+}
+
+template<class T, size_t N, class Overflow>
+constexpr typename StaticDoublyList<T, N, Overflow>::const_iterator StaticDoublyList<T, N, Overflow>::end() const {
+    return const_iterator(this, nil);
+}
+
+template<class T, size_t N, class Overflow>
+constexpr bool StaticDoublyList<T, N, Overflow>::push_front(const T& val) {
+    if (allocate(val, nil, head_) == nil) {
+        return Overflow::full();
+    }
+    return true;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr bool StaticDoublyList<T, N, Overflow>::push_front(const T&& val) {
+    return push_front(val);
+}
+
+template<class T, size_t N, class Overflow>
+constexpr bool StaticDoublyList<T, N, Overflow>::push_back(const T& val) {
+    if (allocate(val, tail_, nil) == nil) {
+        return Overflow::full();
+    }
+    return true;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr bool StaticDoublyList<T, N, Overflow>::push_back(const T&& val) {
+    return push_back(val);
+}
+
+template<class T, size_t N, class Overflow>
+constexpr void StaticDoublyList<T, N, Overflow>::pop_front() {
+    if (head_ != nil) {
+        release(head_);
+    }
+}
+
+template<class T, size_t N, class Overflow>
+constexpr void StaticDoublyList<T, N, Overflow>::pop_back() {
+    if (tail_ != nil) {
+        release(tail_);
+    }
+}
+
+template<class T, size_t N, class Overflow>
+constexpr size_t StaticDoublyList<T, N, Overflow>::find(const T& val) const {
+    size_t index = 0;
+    for (index_type curr = head_; curr != nil; curr = nodes_[curr].next) {
+        if (nodes_[curr].val == val) {
+            return index;
+        }
+        index++;
+    }
+    return npos;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr size_t StaticDoublyList<T, N, Overflow>::find(const T&& val) const {
+    return find(val);
+}
+
+template<class T, size_t N, class Overflow>
+constexpr bool StaticDoublyList<T, N, Overflow>::insert(const T& val, const size_t& index) {
+    if (index > size_) {
+        throw std::overflow_error("the index overflow error");
+    }
+    index_type next = (index == size_) ? nil : at(index);
+    index_type prev = (next == nil) ? tail_ : nodes_[next].prev;
+    if (allocate(val, prev, next) == nil) {
+        return Overflow::full();
+    }
+    return true;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr bool StaticDoublyList<T, N, Overflow>::insert(const T& val, const size_t&& index) {
+    return insert(val, index);
+}
+
+template<class T, size_t N, class Overflow>
+constexpr bool StaticDoublyList<T, N, Overflow>::insert(const T&& val, const size_t& index) {
+    return insert(val, index);
+}
+
+template<class T, size_t N, class Overflow>
+constexpr bool StaticDoublyList<T, N, Overflow>::insert(const T&& val, const size_t&& index) {
+    return insert(val, index);
+}
+
+template<class T, size_t N, class Overflow>
+constexpr void StaticDoublyList<T, N, Overflow>::remove(const size_t& index) {
+    if (index >= size_) {
+        throw std::overflow_error("The index is overflow");
+    }
+    release(at(index));
+}
+
+template<class T, size_t N, class Overflow>
+constexpr void StaticDoublyList<T, N, Overflow>::remove(const size_t&& index) {
+    remove(index);
+}
+
+template<class T, size_t N, class Overflow>
+constexpr size_t StaticDoublyList<T, N, Overflow>::remove_value(const T& val) {
+    return remove_if([&val](const T& x) { return x == val; });
+}
+
+template<class T, size_t N, class Overflow>
+template<class Pred>
+constexpr size_t StaticDoublyList<T, N, Overflow>::remove_if(Pred pred) {
+    size_t count = 0;
+    index_type curr = head_;
+    while (curr != nil) {
+        index_type next = nodes_[curr].next;
+        if (pred(nodes_[curr].val)) {
+            release(curr);
+            count++;
+        }
+        curr = next;
+    }
+    return count;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr void StaticDoublyList<T, N, Overflow>::reverse() {
+    index_type curr = head_;
+    while (curr != nil) {
+        index_type next = nodes_[curr].next;
+        nodes_[curr].next = nodes_[curr].prev;
+        nodes_[curr].prev = next;
+        curr = next;
+    }
+    index_type old_head = head_;
+    head_ = tail_;
+    tail_ = old_head;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr size_t StaticDoublyList<T, N, Overflow>::size() const {
+    return size_;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr size_t StaticDoublyList<T, N, Overflow>::capacity() const {
+    return N;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr bool StaticDoublyList<T, N, Overflow>::empty() const {
+    return size_ == 0;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr bool StaticDoublyList<T, N, Overflow>::full() const {
+    return size_ == N;
+}
+
+template<class T, size_t N, class Overflow>
+void StaticDoublyList<T, N, Overflow>::print() const {
+    for (index_type curr = head_; curr != nil; curr = nodes_[curr].next) {
+        std::cout << nodes_[curr].val << ' ';
+    }
+    std::cout << std::endl;
+}
+
+template<class T, size_t N, class Overflow>
+void StaticDoublyList<T, N, Overflow>::print_reverse() const {
+    for (index_type curr = tail_; curr != nil; curr = nodes_[curr].prev) {
+        std::cout << nodes_[curr].val << ' ';
+    }
+    std::cout << std::endl;
+}
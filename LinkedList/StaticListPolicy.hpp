@@ -0,0 +1,30 @@
+// file: StaticListPolicy.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+// Overflow policies and index type for StaticSinglyList / StaticDoublyList.
+// A push or insert into a full list calls Overflow::full() and returns its
+// result: throw_on_overflow throws, error_on_overflow makes the call return
+// false. In a constant expression an overflow with throw_on_overflow is a
+// compile error.
+
+struct throw_on_overflow {
+    static bool full() { throw std::overflow_error("the list is full"); };
+};
+
+struct error_on_overflow {
+    static constexpr bool full() { return false; };
+};
+
+// smallest unsigned type holding every slot index plus the "null" index
+template<size_t N>
+struct static_list_index {
+    typedef typename std::conditional<(N < UINT8_MAX), uint8_t,
+            typename std::conditional<(N < UINT16_MAX), uint16_t, uint32_t>::type>::type type;
+    static_assert(N < UINT32_MAX, "the static list is too large");
+};
@@ -0,0 +1,413 @@
+// file: StaticSinglyList.hpp
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include "StaticListPolicy.hpp"
+
+// SinglyLinkedList with room for N elements inside the object and no heap use.
+// Nodes live in a std::array and are linked by the smallest index type that
+// fits N; released slots are chained into a free list and reused first.
+// Everything except print() is constexpr, so a list can be filled at compile
+// time. T must be default constructible.
+
+template<class T, class I>
+struct StaticSinglyNode {
+    T val;
+    I next;
+};
+
+template<class T, size_t N, class Overflow = throw_on_overflow>
+class StaticSinglyList {
+    private:
+        typedef typename static_list_index<N>::type index_type;
+        typedef StaticSinglyNode<T, index_type> node_type;
+        static constexpr index_type nil = index_type(-1);
+
+        std::array<node_type, N> nodes_;
+        index_type head_;
+        index_type tail_;
+        index_type free_head_;                            // released slots
+        index_type used_;                                 // slots handed out at least once
+        size_t size_;
+
+        constexpr index_type allocate(const T&, index_type); // take a slot, nil when full
+        constexpr void release(index_type);               // give the slot back to the free list
+        constexpr index_type before(size_t) const;        // slot in front of position
+
+    public:
+        static constexpr size_t npos = -1;
+
+        template<class U>
+        class basic_iterator {                            // forward iterator, U is T or const T
+            private:
+                typedef typename std::conditional<std::is_const<U>::value, const StaticSinglyList, StaticSinglyList>::type list_type;
+                list_type* list_;
+                index_type index_;
+                template<class> friend class basic_iterator;
+            public:
+                typedef std::forward_iterator_tag iterator_category;
+                typedef T value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef U* pointer;
+                typedef U& reference;
+
+                constexpr basic_iterator() : list_(nullptr), index_(nil) {};
+                constexpr basic_iterator(list_type* list, index_type index) : list_(list), index_(index) {};
+                constexpr basic_iterator(const basic_iterator<T>& other) : list_(other.list_), index_(other.index_) {};
+
+                constexpr reference operator*() const { return list_->nodes_[index_].val; };
+                constexpr pointer operator->() const { return &list_->nodes_[index_].val; };
+                constexpr basic_iterator& operator++() { index_ = list_->nodes_[index_].next; return *this; };
+                constexpr basic_iterator operator++(int) { basic_iterator old = *this; ++*this; return old; };
+                constexpr bool operator==(const basic_iterator& other) const { return index_ == other.index_; };
+                constexpr bool operator!=(const basic_iterator& other) const { return index_ != other.index_; };
+        };
+        typedef basic_iterator<T> iterator;
+        typedef basic_iterator<const T> const_iterator;
+
+        constexpr StaticSinglyList();                     // constructor
+
+        constexpr T& front();                             // return head element
+        constexpr const T& front() const;                 // overloading front()
+        constexpr T& back();                              // return tail element
+        constexpr const T& back() const;                  // overloading back()
+        constexpr void clear();                           // make the linked List to empty
+
+        constexpr iterator begin();                       // iterator to the front element
+        constexpr iterator end();                         // iterator past the last element
+        constexpr const_iterator begin() const;           // overloading begin()
+        constexpr const_iterator end() const;             // overloading end()
+
+        constexpr bool push_front(const T&);              // insert element to front of Linked list, false when full
+        constexpr bool push_front(const T&&);             // overloading push_front()
+
+        constexpr bool push_back(const T&);               // insert element to end of Linked list, false when full
+        constexpr bool push_back(const T&&);              // overloading push_back()
+
+        constexpr void pop_front();                       // remove the front element in Linked list
+
+        constexpr void pop_back();                        // remove the end elemnt in Linked list
+
+        constexpr size_t find(const T&) const;            // check the value is exit in the linked list and return the index
+        constexpr size_t find(const T&&) const;           // overloading find()
+
+        constexpr bool insert(const T&, const size_t&);   // insert elements according to the index, false when full
+        constexpr bool insert(const T&, const size_t&&);  // overloading insert()
+        constexpr bool insert(const T&&, const size_t&);  // overloading insert()
+        constexpr bool insert(const T&&, const size_t&&); // overloading insert()
+
+        constexpr void remove(const size_t&);             // remove element by index
+        constexpr void remove(const size_t&&);            // overloading remove()
+        constexpr size_t remove_value(const T&);          // remove every element equal to the value in one pass, return the count
+        template<class Pred>
+        constexpr size_t remove_if(Pred);                 // remove every element matching pred in one pass, return the count
+
+        constexpr void reverse();                         // reverse the Linked list
+
+        constexpr size_t size() const;                    // return size of Linked list;
+        constexpr size_t capacity() const;                // maximum number of elements
+        constexpr bool empty() const;                     // check the Linked list is empty
+        constexpr bool full() const;                      // check the Linked list has no free slot
+        void print() const;                               // print the elements of Linked list from front to end
+};
+
+template<class T, size_t N, class Overflow>
+constexpr typename StaticSinglyList<T, N, Overflow>::index_type StaticSinglyList<T, N, Overflow>::allocate(const T& val, index_type next) {
+    index_type i = nil;
+    if (free_head_ != nil) {
+        i = free_head_;
+        free_head_ = nodes_[i].next;
+    } else if (used_ < N) {
+        i = used_++;
+    } else {
+        return nil;
+    }
+    nodes_[i].val = val;
+    nodes_[i].next = next;
+    size_++;
+    return i;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr void StaticSinglyList<T, N, Overflow>::release(index_type i) {
+    nodes_[i].next = free_head_;
+    free_head_ = i;
+    size_--;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr typename StaticSinglyList<T, N, Overflow>::index_type StaticSinglyList<T, N, Overflow>::before(size_t index) const {
+    index_type prev = head_;
+    for (size_t i = 1; i < index; i++) {
+        prev = nodes_[prev].next;
+    }
+    return prev;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr StaticSinglyList<T, N, Overflow>::StaticSinglyList() : nodes_(), head_(nil), tail_(nil), free_head_(nil), used_(0), size_(0) {}
+
+template<class T, size_t N, class Overflow>
+constexpr T& StaticSinglyList<T, N, Overflow>::front() {
+    return nodes_[head_].val;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr const T& StaticSinglyList<T, N, Overflow>::front() const {
+    return nodes_[head_].val;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr T& StaticSinglyList<T, N, Overflow>::back() {
+    return nodes_[tail_].val;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr const T& StaticSinglyList<T, N, Overflow>::back() const {
+    return nodes_[tail_].val;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr void StaticSinglyList<T, N, Overflow>::clear() {
+    head_ = nil;
+    tail_ = nil;
+    free_head_ = nil;
+    used_ = 0;
+    size_ = 0;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr typename StaticSinglyList<T, N, Overflow>::iterator StaticSinglyList<T, N, Overflow>::begin() {
+    return iterator(this, head_);
+}
+
+template<class T, size_t N, class Overflow>
+constexpr typename StaticSinglyList<T, N, Overflow>::iterator StaticSinglyList<T, N, Overflow>::end() {
+    return iterator(this, nil);
+}
+
+template<class T, size_t N, class Overflow>
+constexpr typename StaticSinglyList<T, N, Overflow>::const_iterator StaticSinglyList<T, N, Overflow>::begin() const {
+    return const_iterator(this, head_);
+}
+
+template<class T, size_t N, class Overflow>
+constexpr typename StaticSinglyList<T, N, Overflow>::const_iterator StaticSinglyList<T, N, Overflow>::end() const {
+    return const_iterator(this, nil);
+}
+
+template<class T, size_t N, class Overflow>
+constexpr bool StaticSinglyList<T, N, Overflow>::push_front(const T& val) {
+    index_type new_head = allocate(val, head_);
+    if (new_head == nil) {
+        return Overflow::full();
+    }
+    head_ = new_head;
+    if (tail_ == nil) {
+        tail_ = new_head;
+    }
+    return true;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr bool StaticSinglyList<T, N, Overflow>::push_front(const T&& val) {
+    return push_front(val);
+}
+
+template<class T, size_t N, class Overflow>
+constexpr bool StaticSinglyList<T, N, Overflow>::push_back(const T& val) {
+    index_type new_tail = allocate(val, nil);
+    if (new_tail == nil) {
+        return Overflow::full();
+    }
+    if (tail_ == nil) {
+        head_ = new_tail;
+    } else {
+        nodes_[tail_].next = new_tail;
+    }
+    tail_ = new_tail;
+    return true;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr bool StaticSinglyList<T, N, Overflow>::push_back(const T&& val) {
+    return push_back(val);
+}
+
+template<class T, size_t N, class Overflow>
+constexpr void StaticSinglyList<T, N, Overflow>::pop_front() {
+    if (head_ != nil) {
+        index_type new_head = nodes_[head_].next;
+        release(head_);
+        head_ = new_head;
+        if (head_ == nil) {
+            tail_ = nil;
+        }
+    }
+}
+
+template<class T, size_t N, class Overflow>
+constexpr void StaticSinglyList<T, N, Overflow>::pop_back() {
+    if (head_ != nil) {
+        if (head_ == tail_) {
+            pop_front();
+        } else {
+            index_type prev = before(size_ - 1);
+            release(tail_);
+            nodes_[prev].next = nil;
+            tail_ = prev;
+        }
+    }
+}
+
+template<class T, size_t N, class Overflow>
+constexpr size_t StaticSinglyList<T, N, Overflow>::find(const T& val) const {
+    size_t index = 0;
+    for (index_type curr = head_; curr != nil; curr = nodes_[curr].next) {
+        if (nodes_[curr].val == val) {
+            return index;
+        }
+        index++;
+    }
+    return npos;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr size_t StaticSinglyList<T, N, Overflow>::find(const T&& val) const {
+    return find(val);
+}
+
+template<class T, size_t N, class Overflow>
+constexpr bool StaticSinglyList<T, N, Overflow>::insert(const T& val, const size_t& index) {
+    if (index > size_) {
+        throw std::overflow_error("the index overflow error");
+    }
+    if (index == 0) {
+        return push_front(val);
+    }
+    if (index == size_) {
+        return push_back(val);
+    }
+    index_type prev = before(index);
+    index_type insert_node = allocate(val, nodes_[prev].next);
+    if (insert_node == nil) {
+        return Overflow::full();
+    }
+    nodes_[prev].next = insert_node;
+    return true;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr bool StaticSinglyList<T, N, Overflow>::insert(const T& val, const size_t&& index) {
+    return insert(val, index);
+}
+
+template<class T, size_t N, class Overflow>
+constexpr bool StaticSinglyList<T, N, Overflow>::insert(const T&& val, const size_t& index) {
+    return insert(val, index);
+}
+
+template<class T, size_t N, class Overflow>
+constexpr bool StaticSinglyList<T, N, Overflow>::insert(const T&& val, const size_t&& index) {
+    return insert(val, index);
+}
+
+template<class T, size_t N, class Overflow>
+constexpr void StaticSinglyList<T, N, Overflow>::remove(const size_t& index) {
+    if (index >= size_) {
+        throw std::overflow_error("The index is overflow");
+    }
+    if (index == 0) {
+        pop_front();
+    } else {
+        index_type prev = before(index);
+        index_type curr = nodes_[prev].next;
+        nodes_[prev].next = nodes_[curr].next;
+        if (curr == tail_) {
+            tail_ = prev;
+        }
+        release(curr);
+    }
+}
+
+template<class T, size_t N, class Overflow>
+constexpr void StaticSinglyList<T, N, Overflow>::remove(const size_t&& index) {
+    remove(index);
+}
+
+template<class T, size_t N, class Overflow>
+constexpr size_t StaticSinglyList<T, N, Overflow>::remove_value(const T& val) {
+    return remove_if([&val](const T& x) { return x == val; });
+}
+
+template<class T, size_t N, class Overflow>
+template<class Pred>
+constexpr size_t StaticSinglyList<T, N, Overflow>::remove_if(Pred pred) {
+    index_type last = nil;                                // last slot kept
+    index_type curr = head_;
+    size_t count = 0;
+    while (curr != nil) {
+        index_type next = nodes_[curr].next;
+        if (pred(nodes_[curr].val)) {
+            if (last == nil) {
+                head_ = next;
+            } else {
+                nodes_[last].next = next;
+            }
+            release(curr);
+            count++;
+        } else {
+            last = curr;
+        }
+        curr = next;
+    }
+    tail_ = last;
+    return count;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr void StaticSinglyList<T, N, Overflow>::reverse() {
+    index_type prev = nil;
+    index_type curr = head_;
+    tail_ = head_;
+    while (curr != nil) {
+        index_type next = nodes_[curr].next;
+        nodes_[curr].next = prev;
+        prev = curr;
+        curr = next;
+    }
+    head_ = prev;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr size_t StaticSinglyList<T, N, Overflow>::size() const {
+    return size_;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr size_t StaticSinglyList<T, N, Overflow>::capacity() const {
+    return N;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr bool StaticSinglyList<T, N, Overflow>::empty() const {
+    return size_ == 0;
+}
+
+template<class T, size_t N, class Overflow>
+constexpr bool StaticSinglyList<T, N, Overflow>::full() const {
+    return size_ == N;
+}
+
+template<class T, size_t N, class Overflow>
+void StaticSinglyList<T, N, Overflow>::print() const {
+    for (index_type curr = head_; curr != nil; curr = nodes_[curr].next) {
+        std::cout << nodes_[curr].val << ' ';
+    }
+    std::cout << std::endl;
+}
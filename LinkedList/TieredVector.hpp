@@ -0,0 +1,784 @@
+// file: TieredVector.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "ElementWriter.hpp"
+#include "KeySearch.hpp"
+
+// Tiered vector: a circular deque of circular arrays ("blocks") of b slots
+// each, b a power of two. Every block but the first and the last is full, so
+// the block and the slot of an index follow from the size of the first block
+// with a shift and a mask.
+// Same interface as DoublyLinkedList, plus operator[] and at():
+// index access is O(1), push / pop at either end amortized O(1), and insert /
+// remove in the middle shift at most one block and move one element across
+// each block between the position and the nearer end, O(b + n / b).
+// b is kept near sqrt(n): the blocks are rebuilt with twice the size when
+// n grows past 4 b^2 and with half the size when n drops below b^2 / 16,
+// which makes insert / remove O(sqrt(n)) at an amortized O(1) rebuild cost.
+// Inserting or removing in the middle invalidates iterators and references.
+
+template<class T>
+class TieredVector {
+    private:
+        struct Block {
+            T* slots;                                     // raw storage for b elements
+            size_t head;                                  // slot of the first element
+            size_t count;
+        };
+
+        std::vector<Block> ring_;                         // block ring, its size is a power of two
+        size_t first_;                                    // ring index of the first block
+        size_t blocks_;                                   // blocks in use
+        size_t shift_;                                    // b = 1 << shift_
+        size_t size_;
+        T* spare_;                                        // storage of the last dropped block, kept for reuse
+
+        size_t mask() const;                              // b - 1
+        Block& block(size_t);                             // k-th block from the front
+        const Block& block(size_t) const;
+        T& slot(Block&, size_t) const;                    // element at that offset of the block
+        void locate(size_t, size_t&, size_t&) const;      // block and offset of an index
+
+        T* new_storage();
+        void free_storage(T*);
+        void grow_ring();
+        void add_front_block();
+        void add_back_block();
+        void drop_front_block();                          // requires the first block to be empty
+        void drop_back_block();                           // requires the last block to be empty
+
+        void block_push_front(Block&, const T&);
+        void block_push_back(Block&, const T&);
+        void block_pop_front(Block&);
+        void block_pop_back(Block&);
+        void block_insert(Block&, size_t, const T&);      // requires a block that is not full
+        void block_erase(Block&, size_t);
+
+        void relayout(size_t);                            // move every element into blocks of 1 << shift slots
+        void grow_blocks();                               // double b once n passes 4 b^2
+        void shrink_blocks();                             // halve b once n drops below b^2 / 16
+
+    public:
+        static const size_t npos = -1;
+        static const size_t min_shift = 4;                // blocks never get smaller than 16 slots
+
+        template<class U>
+        class basic_iterator {                            // random access iterator, U is T or const T
+            private:
+                const TieredVector<T>* vec_;
+                size_t index_;
+                template<class> friend class basic_iterator;
+            public:
+                typedef std::random_access_iterator_tag iterator_category;
+                typedef T value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef U* pointer;
+                typedef U& reference;
+
+                basic_iterator() : vec_(nullptr), index_(0) {};
+                basic_iterator(const TieredVector<T>* vec, size_t index) : vec_(vec), index_(index) {};
+                basic_iterator(const basic_iterator<T>& other) : vec_(other.vec_), index_(other.index_) {};
+
+                reference operator*() const { return const_cast<TieredVector<T>*>(vec_)->operator[](index_); };
+                pointer operator->() const { return &**this; };
+                reference operator[](difference_type n) const { return *(*this + n); };
+                basic_iterator& operator++() { index_++; return *this; };
+                basic_iterator operator++(int) { basic_iterator old = *this; index_++; return old; };
+                basic_iterator& operator--() { index_--; return *this; };
+                basic_iterator operator--(int) { basic_iterator old = *this; index_--; return old; };
+                basic_iterator& operator+=(difference_type n) { index_ += n; return *this; };
+                basic_iterator& operator-=(difference_type n) { index_ -= n; return *this; };
+                basic_iterator operator+(difference_type n) const { return basic_iterator(vec_, index_ + n); };
+                basic_iterator operator-(difference_type n) const { return basic_iterator(vec_, index_ - n); };
+                friend basic_iterator operator+(difference_type n, const basic_iterator& it) { return it + n; };
+                difference_type operator-(const basic_iterator& other) const { return difference_type(index_) - difference_type(other.index_); };
+                bool operator==(const basic_iterator& other) const { return index_ == other.index_; };
+                bool operator!=(const basic_iterator& other) const { return index_ != other.index_; };
+                bool operator<(const basic_iterator& other) const { return index_ < other.index_; };
+                bool operator>(const basic_iterator& other) const { return index_ > other.index_; };
+                bool operator<=(const basic_iterator& other) const { return index_ <= other.index_; };
+                bool operator>=(const basic_iterator& other) const { return index_ >= other.index_; };
+        };
+        typedef basic_iterator<T> iterator;
+        typedef basic_iterator<const T> const_iterator;
+
+        TieredVector();                                   // constructor
+        ~TieredVector();                                  // destructor
+        TieredVector(const TieredVector<T>&) = delete;
+        TieredVector<T>& operator=(const TieredVector<T>&) = delete;
+        TieredVector(TieredVector<T>&&) noexcept;         // move constructor, takes over the blocks in O(1)
+        TieredVector<T>& operator=(TieredVector<T>&&) noexcept; // move assignment
+        void swap(TieredVector<T>&) noexcept;             // exchange the contents in O(1)
+
+        T& front();                                       // return the first element
+        T& back();                                        // return the last element
+        T& operator[](size_t);                            // element at the index, unchecked
+        const T& operator[](size_t) const;                // overloading operator[]
+        T& at(const size_t&);                             // element at the index, throws past the end
+        const T& at(const size_t&) const;                 // overloading at()
+        void clear();                                     // make the vector empty
+
+        iterator begin();                                 // iterator to the front element
+        iterator end();                                   // iterator past the last element
+        const_iterator begin() const;                     // overloading begin()
+        const_iterator end() const;                       // overloading end()
+
+        void push_front(const T&);                        // insert element to the front
+        void push_front(const T&&);                       // overloading push_front()
+
+        void push_back(const T&);                         // insert element to the end
+        void push_back(const T&&);                        // overloading push_back()
+
+        void pop_front();                                 // remove the front element
+
+        void pop_back();                                  // remove the end element
+
+        size_t find(const T&) const;                      // check the value is exit in the vector and return the index
+        size_t find(const T&&) const;                     // overloading find()
+        std::vector<size_t> find_many(const T*, size_t) const; // index of each key in one pass, npos when absent
+
+        void insert(const T&, const size_t&);             // insert elements according to the index
+        void insert(const T&, const size_t&&);            // overloading insert()
+        void insert(const T&&, const size_t&);            // overloading insert()
+        void insert(const T&&, const size_t&&);           // overloading insert()
+
+        void remove(const size_t&);                       // remove element by index
+        void remove(const size_t&&);                      // overloading remove()
+        size_t remove_value(const T&);                    // remove every element equal to the value in one pass, return the count
+        template<class Pred>
+        size_t remove_if(Pred);                           // remove every element matching pred in one pass, return the count
+
+        void reverse();                                   // reverse the vector
+
+        size_t size() const;                              // return size of the vector
+        bool empty() const;                               // check the vector is empty
+        size_t block_size() const;                        // slots per block, b
+        void write_to(ElementWriter&, const char* = " ", const char* = "\n") const; // the elements, the separator between them, then the terminator
+        void write_to(std::ostream&, const char* = " ", const char* = "\n") const; // buffered write to the stream, does not flush it
+        void write_to(int, const char* = " ", const char* = "\n") const; // buffered write to the file descriptor, one write() per buffer
+        void print() const;                               // print the elements from front to end
+        void print_reverse() const;                       // print the elements from end to front
+};
+
+template<class T>
+size_t TieredVector<T>::mask() const {
+    return (size_t(1) << shift_) - 1;
+}
+
+template<class T>
+typename TieredVector<T>::Block& TieredVector<T>::block(size_t k) {
+    return ring_[(first_ + k) & (ring_.size() - 1)];
+}
+
+template<class T>
+const typename TieredVector<T>::Block& TieredVector<T>::block(size_t k) const {
+    return ring_[(first_ + k) & (ring_.size() - 1)];
+}
+
+template<class T>
+T& TieredVector<T>::slot(Block& b, size_t offset) const {
+    return b.slots[(b.head + offset) & mask()];
+}
+
+template<class T>
+void TieredVector<T>::locate(size_t index, size_t& k, size_t& offset) const {
+    size_t first_count = block(0).count;
+    if (index < first_count) {
+        k = 0;
+        offset = index;
+    } else {
+        index -= first_count;
+        k = 1 + (index >> shift_);
+        offset = index & mask();
+    }
+}
+
+template<class T>
+T* TieredVector<T>::new_storage() {
+    if (spare_ != nullptr) {
+        T* storage = spare_;
+        spare_ = nullptr;
+        return storage;
+    }
+    return static_cast<T*>(::operator new(sizeof(T) << shift_));
+}
+
+template<class T>
+void TieredVector<T>::free_storage(T* storage) {
+    if (spare_ == nullptr) {
+        spare_ = storage;
+    } else {
+        ::operator delete(storage);
+    }
+}
+
+template<class T>
+void TieredVector<T>::grow_ring() {
+    std::vector<Block> ring(ring_.empty() ? 4 : ring_.size() * 2);
+    for (size_t k = 0; k < blocks_; k++) {
+        ring[k] = block(k);
+    }
+    ring_.swap(ring);
+    first_ = 0;
+}
+
+template<class T>
+void TieredVector<T>::add_front_block() {
+    if (blocks_ == ring_.size()) {
+        grow_ring();
+    }
+    first_ = (first_ - 1) & (ring_.size() - 1);
+    blocks_++;
+    block(0) = Block{new_storage(), 0, 0};
+}
+
+template<class T>
+void TieredVector<T>::add_back_block() {
+    if (blocks_ == ring_.size()) {
+        grow_ring();
+    }
+    blocks_++;
+    block(blocks_ - 1) = Block{new_storage(), 0, 0};
+}
+
+template<class T>
+void TieredVector<T>::drop_front_block() {
+    free_storage(block(0).slots);
+    first_ = (first_ + 1) & (ring_.size() - 1);
+    blocks_--;
+}
+
+template<class T>
+void TieredVector<T>::drop_back_block() {
+    free_storage(block(blocks_ - 1).slots);
+    blocks_--;
+}
+
+template<class T>
+void TieredVector<T>::block_push_front(Block& b, const T& val) {
+    size_t head = (b.head - 1) & mask();
+    new (&b.slots[head]) T(val);
+    b.head = head;
+    b.count++;
+}
+
+template<class T>
+void TieredVector<T>::block_push_back(Block& b, const T& val) {
+    new (&b.slots[(b.head + b.count) & mask()]) T(val);
+    b.count++;
+}
+
+template<class T>
+void TieredVector<T>::block_pop_front(Block& b) {
+    b.slots[b.head].~T();
+    b.head = (b.head + 1) & mask();
+    b.count--;
+}
+
+template<class T>
+void TieredVector<T>::block_pop_back(Block& b) {
+    slot(b, b.count - 1).~T();
+    b.count--;
+}
+
+template<class T>
+void TieredVector<T>::block_insert(Block& b, size_t offset, const T& val) {
+    // shift the shorter side by one slot, the block is circular so both work
+    if (offset == b.count) {
+        block_push_back(b, val);
+    } else if (offset == 0) {
+        block_push_front(b, val);
+    } else if (offset >= b.count - offset) {
+        new (&slot(b, b.count)) T(std::move(slot(b, b.count - 1)));
+        for (size_t i = b.count - 1; i > offset; i--) {
+            slot(b, i) = std::move(slot(b, i - 1));
+        }
+        slot(b, offset) = val;
+        b.count++;
+    } else {
+        b.head = (b.head - 1) & mask();
+        b.count++;
+        new (&slot(b, 0)) T(std::move(slot(b, 1)));
+        for (size_t i = 1; i < offset; i++) {
+            slot(b, i) = std::move(slot(b, i + 1));
+        }
+        slot(b, offset) = val;
+    }
+}
+
+template<class T>
+void TieredVector<T>::block_erase(Block& b, size_t offset) {
+    if (offset < b.count - 1 - offset) {
+        for (size_t i = offset; i > 0; i--) {
+            slot(b, i) = std::move(slot(b, i - 1));
+        }
+        block_pop_front(b);
+    } else {
+        for (size_t i = offset; i + 1 < b.count; i++) {
+            slot(b, i) = std::move(slot(b, i + 1));
+        }
+        block_pop_back(b);
+    }
+}
+
+template<class T>
+void TieredVector<T>::relayout(size_t shift) {
+    const size_t new_size = size_t(1) << shift;
+    std::vector<Block> ring(4);
+    while (ring.size() * new_size < size_) {
+        ring.resize(ring.size() * 2);
+    }
+    size_t blocks = 0;
+    for (size_t k = 0; k < blocks_; k++) {
+        Block& b = block(k);
+        for (size_t i = 0; i < b.count; i++) {
+            if (blocks == 0 || ring[blocks - 1].count == new_size) {
+                ring[blocks++] = Block{static_cast<T*>(::operator new(sizeof(T) << shift)), 0, 0};
+            }
+            Block& to = ring[blocks - 1];
+            new (&to.slots[to.count++]) T(std::move(slot(b, i)));
+            slot(b, i).~T();
+        }
+        ::operator delete(b.slots);
+    }
+    if (spare_ != nullptr) {
+        ::operator delete(spare_);
+        spare_ = nullptr;
+    }
+    ring_.swap(ring);
+    first_ = 0;
+    blocks_ = blocks;
+    shift_ = shift;
+}
+
+template<class T>
+void TieredVector<T>::grow_blocks() {
+    if (size_ > (size_t(4) << (2 * shift_))) {
+        relayout(shift_ + 1);
+    }
+}
+
+template<class T>
+void TieredVector<T>::shrink_blocks() {
+    if (shift_ > min_shift && size_ < (size_t(1) << (2 * shift_)) / 16) {
+        relayout(shift_ - 1);
+    }
+}
+
+template<class T>
+TieredVector<T>::TieredVector() {
+    first_ = 0;
+    blocks_ = 0;
+    shift_ = min_shift;
+    size_ = 0;
+    spare_ = nullptr;
+}
+
+template<class T>
+TieredVector<T>::~TieredVector() {
+    clear();
+    if (spare_ != nullptr) {
+        ::operator delete(spare_);
+    }
+}
+
+template<class T>
+TieredVector<T>::TieredVector(TieredVector<T>&& other) noexcept {
+    first_ = 0;
+    blocks_ = 0;
+    shift_ = min_shift;
+    size_ = 0;
+    spare_ = nullptr;
+    swap(other);
+}
+
+template<class T>
+TieredVector<T>& TieredVector<T>::operator=(TieredVector<T>&& other) noexcept {
+    if (this != &other) {
+        TieredVector<T> old(std::move(*this));
+        swap(other);
+    }
+    return *this;
+}
+
+template<class T>
+void TieredVector<T>::swap(TieredVector<T>& other) noexcept {
+    ring_.swap(other.ring_);
+    std::swap(first_, other.first_);
+    std::swap(blocks_, other.blocks_);
+    std::swap(shift_, other.shift_);
+    std::swap(size_, other.size_);
+    std::swap(spare_, other.spare_);
+}
+
+template<class T>
+T& TieredVector<T>::front() {
+    return slot(block(0), 0);
+}
+
+template<class T>
+T& TieredVector<T>::back() {
+    Block& b = block(blocks_ - 1);
+    return slot(b, b.count - 1);
+}
+
+template<class T>
+T& TieredVector<T>::operator[](size_t index) {
+    size_t k, offset;
+    locate(index, k, offset);
+    return slot(block(k), offset);
+}
+
+template<class T>
+const T& TieredVector<T>::operator[](size_t index) const {
+    return const_cast<TieredVector<T>*>(this)->operator[](index);
+}
+
+template<class T>
+T& TieredVector<T>::at(const size_t& index) {
+    if (index >= size_) {
+        throw std::overflow_error("The index is overflow");
+    }
+    return (*this)[index];
+}
+
+template<class T>
+const T& TieredVector<T>::at(const size_t& index) const {
+    if (index >= size_) {
+        throw std::overflow_error("The index is overflow");
+    }
+    return (*this)[index];
+}
+
+template<class T>
+void TieredVector<T>::clear() {
+    while (blocks_ != 0) {
+        Block& b = block(blocks_ - 1);
+        while (b.count != 0) {
+            block_pop_back(b);
+        }
+        drop_back_block();
+    }
+    first_ = 0;
+    size_ = 0;
+}
+
+template<class T>
+typename TieredVector<T>::iterator TieredVector<T>::begin() {
+    return iterator(this, 0);
+}
+
+template<class T>
+typename TieredVector<T>::iterator TieredVector<T>::end() {
+    return iterator(this, size_);
+}
+
+template<class T>
+typename TieredVector<T>::const_iterator TieredVector<T>::begin() const {
+    return const_iterator(this, 0);
+}
+
+template<class T>
+typename TieredVector<T>::const_iterator TieredVector<T>::end() const {
+    return const_iterator(this, size_);
+}
+
+template<class T>
+void TieredVector<T>::push_front(const T& val) {
+    if (blocks_ == 0 || block(0).count == mask() + 1) {
+        add_front_block();
+    }
+    block_push_front(block(0), val);
+    size_++;
+    grow_blocks();
+}
+
+template<class T>
+void TieredVector<T>::push_front(const T&& val) {
+    push_front(val);
+}
+
+template<class T>
+void TieredVector<T>::push_back(const T& val) {
+    if (blocks_ == 0 || block(blocks_ - 1).count == mask() + 1) {
+        add_back_block();
+    }
+    block_push_back(block(blocks_ - 1), val);
+    size_++;
+    grow_blocks();
+}
+
+template<class T>
+void TieredVector<T>::push_back(const T&& val) {
+    push_back(val);
+}
+
+template<class T>
+void TieredVector<T>::pop_front() {
+    if (size_ != 0) {
+        block_pop_front(block(0));
+        if (block(0).count == 0) {
+            drop_front_block();
+        }
+        size_--;
+        shrink_blocks();
+    }
+}
+
+template<class T>
+void TieredVector<T>::pop_back() {
+    if (size_ != 0) {
+        block_pop_back(block(blocks_ - 1));
+        if (block(blocks_ - 1).count == 0) {
+            drop_back_block();
+        }
+        size_--;
+        shrink_blocks();
+    }
+}
+
+template<class T>
+size_t TieredVector<T>::find(const T& val) const {
+    size_t index = 0;
+    for (size_t k = 0; k < blocks_; k++) {
+        const Block& b = block(k);
+        for (size_t i = 0; i < b.count; i++) {
+            if (b.slots[(b.head + i) & mask()] == val) {
+                return index + i;
+            }
+        }
+        index += b.count;
+    }
+    return npos;
+}
+
+template<class T>
+size_t TieredVector<T>::find(const T&& val) const {
+    return find(val);
+}
+
+template<class T>
+std::vector<size_t> TieredVector<T>::find_many(const T* keys, size_t count) const {
+    KeySearch<T> search(keys, count);
+    for (size_t k = 0; k < blocks_ && !search.done(); k++) {
+        const Block& b = block(k);
+        for (size_t i = 0; i < b.count; i++) {
+            search.add(b.slots[(b.head + i) & mask()]);
+        }
+    }
+    return search.positions();
+}
+
+template<class T>
+void TieredVector<T>::insert(const T& val, const size_t& index) {
+    if (index > size_) {
+        throw std::overflow_error("the index overflow error");
+    }
+    if (index == 0) {
+        push_front(val);
+        return;
+    }
+    if (index == size_) {
+        push_back(val);
+        return;
+    }
+
+    const size_t full = mask() + 1;
+    size_t k, offset;
+    locate(index, k, offset);
+    if (index < size_ / 2) {
+        // make room in front: each block up to k hands its first element to the one before
+        if (offset == 0) {
+            k--;                                          // append to the block before instead
+            offset = block(k).count;
+        }
+        if (block(k).count < full) {
+            block_insert(block(k), offset, val);
+        } else {
+            if (block(0).count == full) {
+                add_front_block();
+                k++;
+            }
+            for (size_t j = 0; j < k; j++) {
+                block_push_back(block(j), std::move(slot(block(j + 1), 0)));
+                block_pop_front(block(j + 1));
+            }
+            block_insert(block(k), offset - 1, val);
+        }
+    } else {
+        // make room at the back: each block from k on hands its last element to the one after
+        if (block(k).count < full) {
+            block_insert(block(k), offset, val);
+        } else {
+            if (block(blocks_ - 1).count == full) {
+                add_back_block();
+            }
+            for (size_t j = blocks_ - 1; j > k; j--) {
+                Block& prev = block(j - 1);
+                block_push_front(block(j), std::move(slot(prev, prev.count - 1)));
+                block_pop_back(prev);
+            }
+            block_insert(block(k), offset, val);
+        }
+    }
+    size_++;
+    grow_blocks();
+}
+
+template<class T>
+void TieredVector<T>::insert(const T& val, const size_t&& index) {
+    insert(val, index);
+}
+
+template<class T>
+void TieredVector<T>::insert(const T&& val, const size_t& index) {
+    insert(val, index);
+}
+
+template<class T>
+void TieredVector<T>::insert(const T&& val, const size_t&& index) {
+    insert(val, index);
+}
+
+template<class T>
+void TieredVector<T>::remove(const size_t& index) {
+    if (index >= size_) {
+        throw std::overflow_error("The index is overflow");
+    }
+
+    if (index == 0) {
+        pop_front();
+    } else if (index == size_ - 1) {
+        pop_back();
+    } else {
+        size_t k, offset;
+        locate(index, k, offset);
+        block_erase(block(k), offset);
+        if (k != 0 && k != blocks_ - 1) {
+            // refill block k from the nearer end, which may run empty
+            if (k < blocks_ / 2) {
+                for (size_t j = k; j > 0; j--) {
+                    Block& prev = block(j - 1);
+                    block_push_front(block(j), std::move(slot(prev, prev.count - 1)));
+                    block_pop_back(prev);
+                }
+                if (block(0).count == 0) {
+                    drop_front_block();
+                }
+            } else {
+                for (size_t j = k; j < blocks_ - 1; j++) {
+                    block_push_back(block(j), std::move(slot(block(j + 1), 0)));
+                    block_pop_front(block(j + 1));
+                }
+                if (block(blocks_ - 1).count == 0) {
+                    drop_back_block();
+                }
+            }
+        }
+        size_--;
+        shrink_blocks();
+    }
+}
+
+template<class T>
+void TieredVector<T>::remove(const size_t&& index) {
+    remove(index);
+}
+
+template<class T>
+size_t TieredVector<T>::remove_value(const T& val) {
+    return remove_if([&val](const T& x) { return x == val; });
+}
+
+template<class T>
+template<class Pred>
+size_t TieredVector<T>::remove_if(Pred pred) {
+    // compact the kept elements to the front in one pass, then drop the tail
+    size_t kept = 0;
+    for (size_t i = 0; i < size_; i++) {
+        T& x = (*this)[i];
+        if (!pred(x)) {
+            if (kept != i) {
+                (*this)[kept] = std::move(x);
+            }
+            kept++;
+        }
+    }
+    size_t count = size_ - kept;
+    while (size_ > kept) {
+        block_pop_back(block(blocks_ - 1));
+        if (block(blocks_ - 1).count == 0) {
+            drop_back_block();
+        }
+        size_--;
+    }
+    shrink_blocks();
+    return count;
+}
+
+template<class T, class Pred>
+size_t erase_if(TieredVector<T>& vec, Pred pred) {
+    return vec.remove_if(pred);
+}
+
+template<class T>
+void TieredVector<T>::reverse() {
+    for (size_t i = 0, j = size_; i + 1 < j; i++, j--) {
+        std::swap((*this)[i], (*this)[j - 1]);
+    }
+}
+
+template<class T>
+size_t TieredVector<T>::size() const {
+    return size_;
+}
+
+template<class T>
+bool TieredVector<T>::empty() const {
+    return size_ == 0;
+}
+
+template<class T>
+size_t TieredVector<T>::block_size() const {
+    return mask() + 1;
+}
+
+template<class T>
+void TieredVector<T>::write_to(ElementWriter& out, const char* separator, const char* terminator) const {
+    out.put_range(begin(), end(), separator, terminator);
+}
+
+template<class T>
+void TieredVector<T>::write_to(std::ostream& stream, const char* separator, const char* terminator) const {
+    ElementWriter out(stream);
+    write_to(out, separator, terminator);
+    out.write_out();                                      // here, not in the destructor, so a failed write throws
+}
+
+template<class T>
+void TieredVector<T>::write_to(int fd, const char* separator, const char* terminator) const {
+    ElementWriter out(fd);
+    write_to(out, separator, terminator);
+    out.write_out();                                      // here, not in the destructor, so a failed write throws
+}
+
+template<class T>
+void TieredVector<T>::print() const {
+    write_to(std::cout);
+    std::cout.flush();
+}
+
+template<class T>
+void TieredVector<T>::print_reverse() const {
+    ElementWriter out(std::cout);
+    out.put_range(std::make_reverse_iterator(end()), std::make_reverse_iterator(begin()), " ", "\n");
+    out.flush();
+}
@@ -0,0 +1,473 @@
+// file: XorLinkedList.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "KeySearch.hpp"
+#include "NodeAllocator.hpp"
+
+// Doubly linked list whose nodes store a single link, prev ^ next.
+// Same interface as DoublyLinkedList, but one pointer less per node
+// (an int payload takes 16 bytes per node instead of 24 on 64-bit builds).
+// A node can only be reached while walking from one of the ends, so
+// reverse() is O(1): it just swaps head_ and tail_. The iterators carry the
+// (prev, curr) pair of the walk, so they go both ways without a prev link.
+
+template<class T> class XorLinkedList;
+
+template<class T>
+class XorNode {
+    private:
+        T val;
+        uintptr_t link;                                   // address of prev XOR address of next
+    public:
+        XorNode(const T& _val) : val(_val), link(0) {};
+        XorNode(const T& _val, uintptr_t l) : val(_val), link(l) {};
+        static void* operator new(size_t size) { return node_allocator<XorNode<T>>::allocate(size); };
+        static void operator delete(void* p, size_t size) { node_allocator<XorNode<T>>::deallocate(p, size); };
+        friend class XorLinkedList<T>;
+};
+
+template<class T>
+class XorLinkedList {
+    private:
+        XorNode<T>* head_;
+        XorNode<T>* tail_;
+        size_t size_;
+
+        static uintptr_t addr(const XorNode<T>*);
+        static XorNode<T>* step(const XorNode<T>* from, const XorNode<T>* curr);    // the neighbour of curr that is not from
+        void locate(size_t, XorNode<T>*&, XorNode<T>*&) const;                      // nodes at index - 1 and index
+
+    public:
+        static const size_t npos = -1;
+
+        template<class U>
+        class basic_iterator {                            // bidirectional iterator, U is T or const T
+            private:
+                XorNode<T>* prev_;
+                XorNode<T>* curr_;                        // nullptr past the back element
+                template<class> friend class basic_iterator;
+            public:
+                typedef std::bidirectional_iterator_tag iterator_category;
+                typedef T value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef U* pointer;
+                typedef U& reference;
+
+                basic_iterator() : prev_(nullptr), curr_(nullptr) {};
+                basic_iterator(XorNode<T>* prev, XorNode<T>* curr) : prev_(prev), curr_(curr) {};
+                basic_iterator(const basic_iterator<T>& other) : prev_(other.prev_), curr_(other.curr_) {};
+
+                reference operator*() const { return curr_->val; };
+                pointer operator->() const { return &curr_->val; };
+                basic_iterator& operator++() { XorNode<T>* next = step(prev_, curr_); prev_ = curr_; curr_ = next; return *this; };
+                basic_iterator operator++(int) { basic_iterator old = *this; ++*this; return old; };
+                basic_iterator& operator--() { XorNode<T>* before = step(curr_, prev_); curr_ = prev_; prev_ = before; return *this; };
+                basic_iterator operator--(int) { basic_iterator old = *this; --*this; return old; };
+                bool operator==(const basic_iterator& other) const { return curr_ == other.curr_ && prev_ == other.prev_; };
+                bool operator!=(const basic_iterator& other) const { return !(*this == other); };
+        };
+        typedef basic_iterator<T> iterator;
+        typedef basic_iterator<const T> const_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        XorLinkedList();                                  // constructor
+        ~XorLinkedList();                                 // destructor
+        XorLinkedList(const XorLinkedList<T>&) = delete;
+        XorLinkedList<T>& operator=(const XorLinkedList<T>&) = delete;
+        XorLinkedList(XorLinkedList<T>&&) noexcept;       // move constructor, takes over the nodes in O(1)
+        XorLinkedList<T>& operator=(XorLinkedList<T>&&) noexcept; // move assignment
+        void swap(XorLinkedList<T>&) noexcept;            // exchange the contents in O(1)
+
+        T& front();                                       // return head element
+        T& back();                                        // return tail element
+        void clear();                                     // make the linked List to empty
+
+        iterator begin();                                 // iterator to the front element
+        iterator end();                                   // iterator past the back element
+        const_iterator begin() const;                     // overloading begin()
+        const_iterator end() const;                       // overloading end()
+        reverse_iterator rbegin();                        // iterator to the back element, walking to the front
+        reverse_iterator rend();                          // iterator before the front element
+        const_reverse_iterator rbegin() const;            // overloading rbegin()
+        const_reverse_iterator rend() const;              // overloading rend()
+
+        void push_front(const T&);                        // insert element to front of Linked list
+        void push_front(const T&&);                       // overloading push_front()
+
+        void push_back(const T&);                         // insert element to end of Linked list
+        void push_back(const T&&);                        // overloading push_back()
+
+        void pop_front();                                 // remove the front element in Linked list
+
+        void pop_back();                                  // remove the end elemnt in Linked list
+
+        size_t find(const T&) const;                      // check the value is exit in the linked list and return the index
+        size_t find(const T&&) const;                     // overloading find()
+        std::vector<size_t> find_many(const T*, size_t) const; // index of each key in one walk, npos when absent
+
+        void insert(const T&, const size_t&);             // insert elements according to the index
+        void insert(const T&, const size_t&&);            // overloading insert()
+        void insert(const T&&, const size_t&);            // overloading insert()
+        void insert(const T&&, const size_t&&);           // overloading insert()
+
+        void remove(const size_t&);                       // remove element by index
+        void remove(const size_t&&);                      // overloading remove()
+
+        void reverse();                                   // reverse the Linked list in O(1)
+
+        size_t size() const;                              // return size of Linked list;
+        bool empty() const;                               // check the Linked list is empty
+        void print() const;                               // print the elements of Linked list from front to end
+        void print_reverse() const;                       // print the elements of Linked list from end to front
+};
+
+template<class T>
+uintptr_t XorLinkedList<T>::addr(const XorNode<T>* node) {
+    return reinterpret_cast<uintptr_t>(node);
+}
+
+template<class T>
+XorNode<T>* XorLinkedList<T>::step(const XorNode<T>* from, const XorNode<T>* curr) {
+    return reinterpret_cast<XorNode<T>*>(curr->link ^ addr(from));
+}
+
+template<class T>
+void XorLinkedList<T>::locate(size_t index, XorNode<T>*& prev, XorNode<T>*& curr) const {
+    // requires 0 < index < size_
+    if (index > size_ / 2) {
+        XorNode<T>* next = nullptr;
+        curr = tail_;
+        for (size_t i = 0; i < size_ - index - 1; i++) {
+            XorNode<T>* before = step(next, curr);
+            next = curr;
+            curr = before;
+        }
+        prev = step(next, curr);
+    } else {
+        prev = nullptr;
+        curr = head_;
+        for (size_t i = 0; i < index; i++) {
+            XorNode<T>* after = step(prev, curr);
+            prev = curr;
+            curr = after;
+        }
+    }
+}
+
+template<class T>
+XorLinkedList<T>::XorLinkedList() {
+    head_ = nullptr;
+    tail_ = nullptr;
+    size_ = 0;
+}
+
+template<class T>
+XorLinkedList<T>::~XorLinkedList() {
+    clear();
+}
+
+template<class T>
+XorLinkedList<T>::XorLinkedList(XorLinkedList<T>&& other) noexcept {
+    head_ = nullptr;
+    tail_ = nullptr;
+    size_ = 0;
+    swap(other);
+}
+
+template<class T>
+XorLinkedList<T>& XorLinkedList<T>::operator=(XorLinkedList<T>&& other) noexcept {
+    if (this != &other) {
+        clear();
+        swap(other);
+    }
+    return *this;
+}
+
+template<class T>
+void XorLinkedList<T>::swap(XorLinkedList<T>& other) noexcept {
+    std::swap(head_, other.head_);
+    std::swap(tail_, other.tail_);
+    std::swap(size_, other.size_);
+}
+
+template<class T>
+void swap(XorLinkedList<T>& a, XorLinkedList<T>& b) noexcept {
+    a.swap(b);
+}
+
+template<class T>
+T& XorLinkedList<T>::front() {
+    return head_->val;
+}
+
+template<class T>
+T& XorLinkedList<T>::back() {
+    return tail_->val;
+}
+
+template<class T>
+void XorLinkedList<T>::clear() {
+    XorNode<T>* prev = nullptr;
+    XorNode<T>* curr = head_;
+    while (curr != nullptr) {
+        XorNode<T>* next = step(prev, curr);
+        delete prev;
+        prev = curr;
+        curr = next;
+    }
+    delete prev;
+    head_ = nullptr;
+    tail_ = nullptr;
+    size_ = 0;
+}
+
+template<class T>
+typename XorLinkedList<T>::iterator XorLinkedList<T>::begin() {
+    return iterator(nullptr, head_);
+}
+
+template<class T>
+typename XorLinkedList<T>::iterator XorLinkedList<T>::end() {
+    return iterator(tail_, nullptr);
+}
+
+template<class T>
+typename XorLinkedList<T>::const_iterator XorLinkedList<T>::begin() const {
+    return const_iterator(nullptr, head_);
+}
+
+template<class T>
+typename XorLinkedList<T>::const_iterator XorLinkedList<T>::end() const {
+    return const_iterator(tail_, nullptr);
+}
+
+template<class T>
+typename XorLinkedList<T>::reverse_iterator XorLinkedList<T>::rbegin() {
+    return reverse_iterator(end());
+}
+
+template<class T>
+typename XorLinkedList<T>::reverse_iterator XorLinkedList<T>::rend() {
+    return reverse_iterator(begin());
+}
+
+template<class T>
+typename XorLinkedList<T>::const_reverse_iterator XorLinkedList<T>::rbegin() const {
+    return const_reverse_iterator(end());
+}
+
+template<class T>
+typename XorLinkedList<T>::const_reverse_iterator XorLinkedList<T>::rend() const {
+    return const_reverse_iterator(begin());
+}
+
+template<class T>
+void XorLinkedList<T>::push_front(const T& val) {
+    XorNode<T>* new_head = new XorNode<T>(val, addr(head_));
+    if (head_ == nullptr) {
+        tail_ = new_head;
+    } else {
+        head_->link ^= addr(new_head);
+    }
+    head_ = new_head;
+    size_++;
+}
+
+template<class T>
+void XorLinkedList<T>::push_front(const T&& val) {
+    push_front(val);
+}
+
+template<class T>
+void XorLinkedList<T>::push_back(const T& val) {
+    XorNode<T>* new_tail = new XorNode<T>(val, addr(tail_));
+    if (tail_ == nullptr) {
+        head_ = new_tail;
+    } else {
+        tail_->link ^= addr(new_tail);
+    }
+    tail_ = new_tail;
+    size_++;
+}
+
+template<class T>
+void XorLinkedList<T>::push_back(const T&& val) {
+    push_back(val);
+}
+
+template<class T>
+void XorLinkedList<T>::pop_front() {
+    if (head_ != nullptr) {
+        XorNode<T>* new_head = step(nullptr, head_);
+        if (new_head != nullptr) {
+            new_head->link ^= addr(head_);
+        } else {
+            tail_ = nullptr;
+        }
+        delete head_;
+        head_ = new_head;
+        size_--;
+    }
+}
+
+template<class T>
+void XorLinkedList<T>::pop_back() {
+    if (tail_ != nullptr) {
+        XorNode<T>* new_tail = step(nullptr, tail_);
+        if (new_tail != nullptr) {
+            new_tail->link ^= addr(tail_);
+        } else {
+            head_ = nullptr;
+        }
+        delete tail_;
+        tail_ = new_tail;
+        size_--;
+    }
+}
+
+template<class T>
+size_t XorLinkedList<T>::find(const T& val) const {
+    size_t index = 0;
+    const XorNode<T>* prev = nullptr;
+    const XorNode<T>* curr = head_;
+    while (curr != nullptr && curr->val != val) {
+        const XorNode<T>* next = step(prev, curr);
+        prev = curr;
+        curr = next;
+        index++;
+    }
+    return (curr == nullptr) ? npos : index;
+}
+
+template<class T>
+size_t XorLinkedList<T>::find(const T&& val) const {
+    return find(val);
+}
+
+template<class T>
+std::vector<size_t> XorLinkedList<T>::find_many(const T* keys, size_t count) const {
+    KeySearch<T> search(keys, count);
+    const XorNode<T>* prev = nullptr;
+    const XorNode<T>* curr = head_;
+    while (curr != nullptr && !search.done()) {
+        search.add(curr->val);
+        const XorNode<T>* next = step(prev, curr);
+        prev = curr;
+        curr = next;
+    }
+    return search.positions();
+}
+
+template<class T>
+void XorLinkedList<T>::insert(const T& val, const size_t& index) {
+    if (index > size_) {
+        throw std::overflow_error("the index overflow error");
+    }
+    if (index == 0) {
+        push_front(val);
+    } else if (index == size_) {
+        push_back(val);
+    } else {
+        XorNode<T>* prev;
+        XorNode<T>* curr;
+        locate(index, prev, curr);
+
+        XorNode<T>* insert_node = new XorNode<T>(val, addr(prev) ^ addr(curr));
+        prev->link ^= addr(curr) ^ addr(insert_node);
+        curr->link ^= addr(prev) ^ addr(insert_node);
+        size_++;
+    }
+}
+
+template<class T>
+void XorLinkedList<T>::insert(const T& val, const size_t&& index) {
+    insert(val, index);
+}
+
+template<class T>
+void XorLinkedList<T>::insert(const T&& val, const size_t& index) {
+    insert(val, index);
+}
+
+template<class T>
+void XorLinkedList<T>::insert(const T&& val, const size_t&& index) {
+    insert(val, index);
+}
+
+template<class T>
+void XorLinkedList<T>::remove(const size_t& index) {
+    if (index >= size_) {
+        throw std::overflow_error("The index is overflow");
+    }
+
+    if (index == 0) {
+        pop_front();
+    } else if (index == size_ - 1) {
+        pop_back();
+    } else {
+        XorNode<T>* prev;
+        XorNode<T>* curr;
+        locate(index, prev, curr);
+
+        XorNode<T>* next = step(prev, curr);
+        prev->link ^= addr(curr) ^ addr(next);
+        next->link ^= addr(curr) ^ addr(prev);
+        delete curr;
+        size_--;
+    }
+}
+
+template<class T>
+void XorLinkedList<T>::remove(const size_t&& index) {
+    remove(index);
+}
+
+template<class T>
+void XorLinkedList<T>::reverse() {
+    std::swap(head_, tail_);
+}
+
+template<class T>
+size_t XorLinkedList<T>::size() const {
+    return size_;
+}
+
+template<class T>
+bool XorLinkedList<T>::empty() const {
+    return size_ == 0;
+}
+
+template<class T>
+void XorLinkedList<T>::print() const {
+    const XorNode<T>* prev = nullptr;
+    const XorNode<T>* curr = head_;
+    while (curr != nullptr) {
+        std::cout << curr->val << ' ';
+        const XorNode<T>* next = step(prev, curr);
+        prev = curr;
+        curr = next;
+    }
+    std::cout << std::endl;
+}
+
+template<class T>
+void XorLinkedList<T>::print_reverse() const {
+    const XorNode<T>* next = nullptr;
+    const XorNode<T>* curr = tail_;
+    while (curr != nullptr) {
+        std::cout << curr->val << ' ';
+        const XorNode<T>* prev = step(next, curr);
+        next = curr;
+        curr = prev;
+    }
+    std::cout << std::endl;
+}
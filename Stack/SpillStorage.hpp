@@ -0,0 +1,297 @@
+// file: SpillStorage.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+// External-memory backing for Stack: the elements live in fixed-size blocks,
+// at most memory_bytes of them in memory. When the in-memory blocks are full,
+// the oldest half is appended to a spill file, one large sequential write per
+// block; when the stack runs out of in-memory blocks, the blocks spilled last
+// are read back in one sequential pass. The two thresholds are half the budget
+// apart, so a stack oscillating around either one does not hit the disk on
+// every push / pop. The kernel is told to prefetch the next blocks to read back
+// as soon as the in-memory part drops to a quarter.
+// Elements are written as raw bytes, hence the trivially copyable T.
+// The spill file is an anonymous tmpfile() unless a path is given, in which
+// case that file is created and removed again on destruction.
+template<class T>
+class SpillStorage {
+    private:
+        static_assert(std::is_trivially_copyable<T>::value, "spilled elements must be trivially copyable");
+
+        std::deque<std::vector<T>> blocks_;               // in-memory blocks, the bottom one first, none empty
+        std::vector<std::vector<T>> spare_;               // emptied blocks kept for reuse
+        size_t block_size_;                               // elements per block
+        size_t max_blocks_;                               // in-memory blocks allowed by the budget
+        size_t spilled_;                                  // blocks in the file, stored in stack order from offset 0
+        size_t size_;
+        std::string path_;
+        FILE* file_;
+
+        int fd();                                         // the spill file, created on first use
+        void spill();                                     // write the older half of the in-memory blocks
+        void refill();                                    // read back the blocks spilled last
+        void prefetch();                                  // ask the kernel to read ahead what refill() reads next
+        std::vector<T> new_block();
+
+    public:
+        static const size_t default_memory = size_t(64) << 20;
+        static const size_t default_block = size_t(1) << 20;
+
+        explicit SpillStorage(size_t memory_bytes = default_memory, size_t block_bytes = default_block, const std::string& path = "");
+        ~SpillStorage();
+        SpillStorage(const SpillStorage<T>&) = delete;
+        SpillStorage<T>& operator=(const SpillStorage<T>&) = delete;
+        SpillStorage(SpillStorage<T>&&) noexcept;         // move constructor, takes over the blocks and the file
+        SpillStorage<T>& operator=(SpillStorage<T>&&) noexcept; // move assignment
+        void swap(SpillStorage<T>&) noexcept;             // exchange the contents in O(1)
+
+        T& front();                                       // the top element
+        void push_front(const T&);                        // push on top, may spill older blocks to the file
+        void push_front(const T&&);                       // overloading push_front()
+        void pop_front();                                 // pop the top, may read spilled blocks back
+        void clear();
+
+        size_t size() const;
+        bool empty() const;
+        size_t spilled_blocks() const;                    // blocks currently in the file
+        size_t memory_bytes() const;                      // bytes held by the in-memory blocks
+};
+
+template<class T>
+SpillStorage<T>::SpillStorage(size_t memory_bytes, size_t block_bytes, const std::string& path) {
+    block_size_ = block_bytes / sizeof(T);
+    if (block_size_ == 0) {
+        block_size_ = 1;
+    }
+    max_blocks_ = memory_bytes / (block_size_ * sizeof(T));
+    if (max_blocks_ < 4) {
+        max_blocks_ = 4;
+    }
+    spilled_ = 0;
+    size_ = 0;
+    path_ = path;
+    file_ = nullptr;
+}
+
+template<class T>
+SpillStorage<T>::~SpillStorage() {
+    if (file_ != nullptr) {
+        std::fclose(file_);
+        if (!path_.empty()) {
+            std::remove(path_.c_str());
+        }
+    }
+}
+
+template<class T>
+SpillStorage<T>::SpillStorage(SpillStorage<T>&& other) noexcept {
+    block_size_ = other.block_size_;
+    max_blocks_ = other.max_blocks_;
+    spilled_ = 0;
+    size_ = 0;
+    file_ = nullptr;
+    swap(other);
+}
+
+template<class T>
+SpillStorage<T>& SpillStorage<T>::operator=(SpillStorage<T>&& other) noexcept {
+    if (this != &other) {
+        SpillStorage<T> old(std::move(*this));
+        swap(other);
+    }
+    return *this;
+}
+
+template<class T>
+void SpillStorage<T>::swap(SpillStorage<T>& other) noexcept {
+    std::swap(blocks_, other.blocks_);
+    std::swap(spare_, other.spare_);
+    std::swap(block_size_, other.block_size_);
+    std::swap(max_blocks_, other.max_blocks_);
+    std::swap(spilled_, other.spilled_);
+    std::swap(size_, other.size_);
+    std::swap(path_, other.path_);
+    std::swap(file_, other.file_);
+}
+
+template<class T>
+T& SpillStorage<T>::front() {
+    if (blocks_.empty() && spilled_ != 0) {
+        refill();                                         // an earlier refill() failed
+    }
+    return blocks_.back().back();
+}
+
+template<class T>
+void SpillStorage<T>::push_front(const T& val) {
+    if (blocks_.empty() || blocks_.back().size() == block_size_) {
+        if (blocks_.size() == max_blocks_) {
+            spill();
+        }
+        blocks_.push_back(new_block());
+    }
+    blocks_.back().push_back(val);
+    size_++;
+}
+
+template<class T>
+void SpillStorage<T>::push_front(const T&& val) {
+    push_front(val);
+}
+
+template<class T>
+void SpillStorage<T>::pop_front() {
+    if (size_ == 0) {
+        return;
+    }
+    if (blocks_.empty()) {
+        refill();                                         // an earlier refill() failed
+    }
+    blocks_.back().pop_back();
+    size_--;
+    if (blocks_.back().empty()) {
+        if (spare_.size() < 2) {
+            spare_.push_back(std::move(blocks_.back()));
+        }
+        blocks_.pop_back();
+        if (spilled_ != 0) {
+            if (blocks_.empty()) {
+                refill();
+            } else if (blocks_.size() == max_blocks_ / 4) {
+                prefetch();
+            }
+        }
+    }
+}
+
+template<class T>
+void SpillStorage<T>::clear() {
+    blocks_.clear();
+    spilled_ = 0;
+    size_ = 0;
+}
+
+template<class T>
+size_t SpillStorage<T>::size() const {
+    return size_;
+}
+
+template<class T>
+bool SpillStorage<T>::empty() const {
+    return size_ == 0;
+}
+
+template<class T>
+size_t SpillStorage<T>::spilled_blocks() const {
+    return spilled_;
+}
+
+template<class T>
+size_t SpillStorage<T>::memory_bytes() const {
+    return (blocks_.size() + spare_.size()) * block_size_ * sizeof(T);
+}
+
+template<class T>
+int SpillStorage<T>::fd() {
+    if (file_ == nullptr) {
+        file_ = path_.empty() ? std::tmpfile() : std::fopen(path_.c_str(), "w+b");
+        if (file_ == nullptr) {
+            throw std::runtime_error("cannot create the spill file");
+        }
+    }
+    return fileno(file_);
+}
+
+template<class T>
+std::vector<T> SpillStorage<T>::new_block() {
+    std::vector<T> block;
+    if (!spare_.empty()) {
+        block = std::move(spare_.back());
+        spare_.pop_back();
+        block.clear();
+    } else {
+        block.reserve(block_size_);
+    }
+    return block;
+}
+
+template<class T>
+void SpillStorage<T>::spill() {
+    // the blocks below the top are always full, so every block takes the same
+    // block_size_ * sizeof(T) bytes in the file. Nothing is dropped from memory
+    // until every write has succeeded, a failed spill leaves the stack as it was.
+    int file = fd();
+    const size_t bytes = block_size_ * sizeof(T);
+    size_t count = max_blocks_ / 2;
+    for (size_t i = 0; i < count; i++) {
+        const char* data = reinterpret_cast<const char*>(blocks_[i].data());
+        off_t offset = off_t(spilled_ + i) * off_t(bytes);
+        size_t done = 0;
+        while (done < bytes) {
+            ssize_t n = pwrite(file, data + done, bytes - done, offset + off_t(done));
+            if (n <= 0) {
+                throw std::runtime_error("cannot write the spill file");
+            }
+            done += size_t(n);
+        }
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (spare_.size() < 2) {
+            spare_.push_back(std::move(blocks_.front()));
+        }
+        blocks_.pop_front();
+    }
+    spilled_ += count;
+}
+
+template<class T>
+void SpillStorage<T>::refill() {
+    // the blocks spilled last lie at the end of the file, read them front to back;
+    // they join the stack only once every read has succeeded, so a failed
+    // refill leaves them in the file to be read again
+    int file = fd();
+    const size_t bytes = block_size_ * sizeof(T);
+    size_t count = (spilled_ < max_blocks_ / 2) ? spilled_ : max_blocks_ / 2;
+    size_t first = spilled_ - count;
+    std::vector<std::vector<T>> loaded;
+    loaded.reserve(count);
+    for (size_t i = first; i < spilled_; i++) {
+        std::vector<T> block = new_block();
+        block.resize(block_size_);
+        char* data = reinterpret_cast<char*>(block.data());
+        off_t offset = off_t(i) * off_t(bytes);
+        size_t done = 0;
+        while (done < bytes) {
+            ssize_t n = pread(file, data + done, bytes - done, offset + off_t(done));
+            if (n <= 0) {
+                throw std::runtime_error("cannot read the spill file");
+            }
+            done += size_t(n);
+        }
+        loaded.push_back(std::move(block));
+    }
+    for (std::vector<T>& block : loaded) {
+        blocks_.push_back(std::move(block));
+    }
+    spilled_ = first;
+}
+
+template<class T>
+void SpillStorage<T>::prefetch() {
+#ifdef POSIX_FADV_WILLNEED
+    const size_t bytes = block_size_ * sizeof(T);
+    size_t count = (spilled_ < max_blocks_ / 2) ? spilled_ : max_blocks_ / 2;
+    posix_fadvise(fd(), off_t(spilled_ - count) * off_t(bytes), off_t(count * bytes), POSIX_FADV_WILLNEED);
+#endif
+}
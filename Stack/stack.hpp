@@ -5,24 +5,38 @@
 #pragma once
 
 #include <iostream>
-#include "SinglyLinkedList.hpp"
-
-template<class T>
+#include <utility>
+#include "../LinkedList/SinglyLinkedList.hpp"
+#include "SpillStorage.hpp"
+
+// Backing is the container holding the elements, with push_front / pop_front /
+// front as the top of the stack: SinglyLinkedList by default, or SpillStorage
+// for stacks larger than memory. With a list backing, push(node_type&&) and
+// pop_handle() move nodes in and out without allocating (see NodeHandle.hpp).
+template<class T, class Backing = SinglyLinkedList<T>>
 class Stack {
     private:
-        SinglyLinkedList<T> stack_;
+        Backing stack_;
 
     public:
 
         Stack();
+        explicit Stack(Backing&&);                        // use a configured backing, e.g. a SpillStorage with its memory budget
         ~Stack();
+        Stack(Stack<T, Backing>&&) noexcept;              // move constructor, takes over the elements in O(1)
+        Stack<T, Backing>& operator=(Stack<T, Backing>&&) noexcept; // move assignment
+        void swap(Stack<T, Backing>&) noexcept;           // exchange the contents in O(1)
         
         T& top();
 
         void push(const T&&);
         void push(const T&);
+        template<class B = Backing>
+        void push(typename B::node_type&&);               // push a node extracted from a list of the backing's type, no allocation
 
         void pop();
+        template<class B = Backing>
+        typename B::node_type pop_handle();               // pop the top and hand its node over, throws on an empty stack
 
         void clear();
 
@@ -30,45 +44,77 @@ class Stack {
         bool empty();
 };
 
-template<class T>
-Stack<T>::Stack() {};
+template<class T, class Backing>
+Stack<T, Backing>::Stack() {};
+
+template<class T, class Backing>
+Stack<T, Backing>::Stack(Backing&& backing) : stack_(std::move(backing)) {}
+
+template<class T, class Backing>
+Stack<T, Backing>::~Stack() {}
+
+template<class T, class Backing>
+Stack<T, Backing>::Stack(Stack<T, Backing>&& other) noexcept : stack_(std::move(other.stack_)) {}
+
+template<class T, class Backing>
+Stack<T, Backing>& Stack<T, Backing>::operator=(Stack<T, Backing>&& other) noexcept {
+    stack_ = std::move(other.stack_);
+    return *this;
+}
+
+template<class T, class Backing>
+void Stack<T, Backing>::swap(Stack<T, Backing>& other) noexcept {
+    stack_.swap(other.stack_);
+}
 
-template<class T>
-Stack<T>::~Stack() {
-    stack_.~SinglyLinkedList();
+template<class T, class Backing>
+void swap(Stack<T, Backing>& a, Stack<T, Backing>& b) noexcept {
+    a.swap(b);
 }
 
-template<class T>
-T& Stack<T>::top() {
+template<class T, class Backing>
+T& Stack<T, Backing>::top() {
     return stack_.front();
 }
 
-template<class T>
-void Stack<T>::push(const T&& val) {
+template<class T, class Backing>
+void Stack<T, Backing>::push(const T&& val) {
     stack_.push_front(val);
 }
 
-template<class T>
-void Stack<T>::push(const T& val) {
+template<class T, class Backing>
+void Stack<T, Backing>::push(const T& val) {
     stack_.push_front(val);
 }
 
-template<class T>
-void Stack<T>::pop() {
+template<class T, class Backing>
+template<class B>
+void Stack<T, Backing>::push(typename B::node_type&& node) {
+    stack_.push_front(std::move(node));
+}
+
+template<class T, class Backing>
+void Stack<T, Backing>::pop() {
     stack_.pop_front();
 }
 
-template<class T>
-void Stack<T>::clear() {
+template<class T, class Backing>
+template<class B>
+typename B::node_type Stack<T, Backing>::pop_handle() {
+    return stack_.extract(0);
+}
+
+template<class T, class Backing>
+void Stack<T, Backing>::clear() {
     stack_.clear();
 }
 
-template<class T>
-size_t Stack<T>::size() {
+template<class T, class Backing>
+size_t Stack<T, Backing>::size() {
     return stack_.size();
 }
 
-template<class T>
-bool Stack<T>::empty() {
+template<class T, class Backing>
+bool Stack<T, Backing>::empty() {
     return stack_.empty();
 }
\ No newline at end of file
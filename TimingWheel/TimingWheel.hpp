@@ -0,0 +1,295 @@
+// file: TimingWheel.hpp
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+// Hierarchical hashed timing wheel.
+// Each level is a ring of slots with a cursor_ that advance() moves one slot
+// forward, like CircularLinkedList; when a level's cursor wraps back to slot 0
+// the next level advances too and its current slot is cascaded down.
+// Every slot is a doubly linked ring of timers with a sentinel, so schedule()
+// and cancel() are O(1) splices and a tick only touches the due slot.
+// Timers live in one vector and are linked by 32-bit indices; a handle carries
+// the timer's generation, so cancelling a timer that already fired is a no-op.
+// T must be default constructible (slot sentinels hold an unused T).
+//
+// The slots are not CircularLinkedLists. A circular_link node only links
+// forward, so cancel() would have to walk the slot to find the timer's
+// predecessor, which makes it O(slot length); the doubly linked
+// DoublyCircularLinkedList has no extract(), so a cascade would free and
+// reallocate every timer it moves. Either list costs one allocation per
+// timer, where the index rings reuse vector storage and a cancelled timer's
+// node is back on the free list at once.
+
+template<class T>
+class TimingWheel {
+    private:
+        struct TimerNode {
+            uint32_t prev;
+            uint32_t next;                                // next free node while on the free list
+            uint32_t generation;                          // bumped on release, invalidates old handles
+            uint64_t expiry;                              // absolute tick
+            T val;
+        };
+
+        static const uint32_t nil = UINT32_MAX;
+
+        std::chrono::nanoseconds tick_;
+        std::chrono::steady_clock::time_point start_;
+        size_t levels_;
+        size_t bits_;                                     // log2 of slots per level
+        uint64_t mask_;
+        std::vector<size_t> cursors_;                     // current slot of every level
+        std::vector<TimerNode> nodes_;                    // slot sentinels first, then timers
+        std::vector<T> batch_;                            // values expiring in the current tick
+        uint32_t free_head_;
+        uint64_t now_;
+        size_t size_;
+
+        uint32_t sentinel(size_t, size_t) const;          // node index of a level's slot
+        uint32_t allocate(const T&, uint64_t);
+        void release(uint32_t);
+        void link(uint32_t);                              // put a timer into the slot for its expiry
+        void unlink(uint32_t);
+        bool advance(size_t);                             // move a level's cursor, true when it wraps to 0
+        void cascade(size_t);                             // re-insert the current slot of a level
+
+    public:
+        struct handle {                                   // returned by schedule(), passed to cancel()
+            uint32_t index;
+            uint32_t generation;
+        };
+
+        TimingWheel(std::chrono::nanoseconds tick = std::chrono::milliseconds(1),
+                    size_t levels = 4, size_t slot_bits = 8);
+
+        handle schedule(const T&, uint64_t);              // fire after the given number of ticks (at least 1)
+        handle schedule(const T&, std::chrono::nanoseconds); // fire after a duration, rounded up to ticks
+        bool cancel(const handle&);                       // remove a pending timer, false if it already fired
+
+        template<class Fn>
+        size_t tick(Fn);                                  // advance one tick, pass the expired values to fn as one batch
+        template<class Fn>
+        size_t advance_ticks(uint64_t, Fn);               // run several ticks
+        template<class Fn>
+        size_t poll(std::chrono::steady_clock::time_point, Fn); // run every tick due by the given time
+
+        void reserve(size_t);                             // reserve storage for n timers
+        uint64_t now() const;                             // ticks run so far
+        std::chrono::nanoseconds tick_duration() const;
+        size_t size() const;                              // number of pending timers
+        bool empty() const;
+};
+
+template<class T>
+TimingWheel<T>::TimingWheel(std::chrono::nanoseconds tick, size_t levels, size_t slot_bits) {
+    if (tick.count() <= 0 || levels == 0 || slot_bits == 0 || levels * slot_bits >= 64) {
+        throw std::invalid_argument("invalid timing wheel geometry");
+    }
+    tick_ = tick;
+    start_ = std::chrono::steady_clock::now();
+    levels_ = levels;
+    bits_ = slot_bits;
+    mask_ = (uint64_t(1) << slot_bits) - 1;
+    cursors_.assign(levels, 0);
+    size_t slots = levels << slot_bits;
+    if (slots >= nil) {
+        throw std::overflow_error("the timing wheel has too many slots");
+    }
+    nodes_.resize(slots);
+    for (uint32_t i = 0; i < slots; i++) {
+        nodes_[i].prev = i;
+        nodes_[i].next = i;
+    }
+    free_head_ = nil;
+    now_ = 0;
+    size_ = 0;
+}
+
+template<class T>
+uint32_t TimingWheel<T>::sentinel(size_t level, size_t slot) const {
+    return static_cast<uint32_t>((level << bits_) + slot);
+}
+
+template<class T>
+uint32_t TimingWheel<T>::allocate(const T& val, uint64_t expiry) {
+    uint32_t i;
+    if (free_head_ != nil) {
+        i = free_head_;
+        free_head_ = nodes_[i].next;
+    } else {
+        if (nodes_.size() >= nil) {
+            throw std::overflow_error("the timing wheel is full");
+        }
+        i = static_cast<uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+        nodes_[i].generation = 0;
+    }
+    nodes_[i].expiry = expiry;
+    nodes_[i].val = val;
+    return i;
+}
+
+template<class T>
+void TimingWheel<T>::release(uint32_t i) {
+    nodes_[i].generation++;
+    nodes_[i].next = free_head_;
+    free_head_ = i;
+}
+
+template<class T>
+void TimingWheel<T>::link(uint32_t i) {
+    uint64_t expiry = nodes_[i].expiry;
+    uint64_t delta = (expiry > now_) ? expiry - now_ : 0;
+    size_t level = 0;
+    while (level + 1 < levels_ && delta >> (bits_ * (level + 1)) != 0) {
+        level++;
+    }
+    // past the top level: park in the furthest slot, cascade will move it again
+    uint64_t limit = uint64_t(1) << (bits_ * levels_);
+    uint64_t when = (delta < limit) ? expiry : now_ + limit - 1;
+    uint32_t s = sentinel(level, (when >> (bits_ * level)) & mask_);
+
+    nodes_[i].prev = nodes_[s].prev;
+    nodes_[i].next = s;
+    nodes_[nodes_[s].prev].next = i;
+    nodes_[s].prev = i;
+}
+
+template<class T>
+void TimingWheel<T>::unlink(uint32_t i) {
+    nodes_[nodes_[i].prev].next = nodes_[i].next;
+    nodes_[nodes_[i].next].prev = nodes_[i].prev;
+}
+
+template<class T>
+bool TimingWheel<T>::advance(size_t level) {
+    cursors_[level] = (cursors_[level] + 1) & mask_;
+    return cursors_[level] == 0;
+}
+
+template<class T>
+void TimingWheel<T>::cascade(size_t level) {
+    uint32_t s = sentinel(level, cursors_[level]);
+    uint32_t curr = nodes_[s].next;
+    nodes_[s].prev = s;
+    nodes_[s].next = s;
+    while (curr != s) {
+        uint32_t next = nodes_[curr].next;
+        link(curr);
+        curr = next;
+    }
+}
+
+template<class T>
+typename TimingWheel<T>::handle TimingWheel<T>::schedule(const T& val, uint64_t ticks) {
+    if (ticks == 0) {
+        ticks = 1;
+    }
+    uint32_t i = allocate(val, now_ + ticks);
+    link(i);
+    size_++;
+    return handle{i, nodes_[i].generation};
+}
+
+template<class T>
+typename TimingWheel<T>::handle TimingWheel<T>::schedule(const T& val, std::chrono::nanoseconds delay) {
+    uint64_t ticks = (delay.count() <= 0) ? 1 : uint64_t((delay.count() + tick_.count() - 1) / tick_.count());
+    return schedule(val, ticks);
+}
+
+template<class T>
+bool TimingWheel<T>::cancel(const handle& h) {
+    if (h.index < (levels_ << bits_) || h.index >= nodes_.size() || nodes_[h.index].generation != h.generation) {
+        return false;
+    }
+    unlink(h.index);
+    release(h.index);
+    size_--;
+    return true;
+}
+
+template<class T>
+template<class Fn>
+size_t TimingWheel<T>::tick(Fn fn) {
+    now_++;
+    size_t level = 0;
+    while (level < levels_ && advance(level)) {
+        level++;
+    }
+    for (size_t l = (level < levels_) ? level : levels_ - 1; l > 0; l--) {
+        cascade(l);
+    }
+
+    uint32_t s = sentinel(0, cursors_[0]);
+    uint32_t curr = nodes_[s].next;
+    nodes_[s].prev = s;
+    nodes_[s].next = s;
+    while (curr != s) {
+        uint32_t next = nodes_[curr].next;
+        if (nodes_[curr].expiry > now_) {
+            link(curr);                                   // parked past the top level, not due yet
+        } else {
+            batch_.push_back(nodes_[curr].val);
+            release(curr);
+        }
+        curr = next;
+    }
+
+    size_t count = batch_.size();
+    size_ -= count;
+    if (count != 0) {
+        fn(static_cast<const std::vector<T>&>(batch_));
+        batch_.clear();
+    }
+    return count;
+}
+
+template<class T>
+template<class Fn>
+size_t TimingWheel<T>::advance_ticks(uint64_t ticks, Fn fn) {
+    size_t count = 0;
+    for (uint64_t i = 0; i < ticks; i++) {
+        count += tick(fn);
+    }
+    return count;
+}
+
+template<class T>
+template<class Fn>
+size_t TimingWheel<T>::poll(std::chrono::steady_clock::time_point time, Fn fn) {
+    if (time <= start_) {
+        return 0;
+    }
+    uint64_t due = uint64_t((time - start_) / tick_);
+    return (due > now_) ? advance_ticks(due - now_, fn) : 0;
+}
+
+template<class T>
+void TimingWheel<T>::reserve(size_t n) {
+    nodes_.reserve((levels_ << bits_) + n);
+}
+
+template<class T>
+uint64_t TimingWheel<T>::now() const {
+    return now_;
+}
+
+template<class T>
+std::chrono::nanoseconds TimingWheel<T>::tick_duration() const {
+    return tick_;
+}
+
+template<class T>
+size_t TimingWheel<T>::size() const {
+    return size_;
+}
+
+template<class T>
+bool TimingWheel<T>::empty() const {
+    return size_ == 0;
+}
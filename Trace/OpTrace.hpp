@@ -0,0 +1,254 @@
+// file: OpTrace.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Operation traces of the lists and Stack, replayed by TraceReplay.hpp.
+// File layout: the 4 magic bytes "OPTR", one version byte, then one record
+// per operation: the op byte, followed by the value as a zigzag varint for the
+// ops that take one and the index as a varint for the ops that take one.
+// A push of a small value costs 2 bytes. Values are stored as int64_t:
+// arithmetic and enum values as they are, anything else as its std::hash.
+enum trace_op : uint8_t {
+    op_push_front, op_push_back, op_pop_front, op_pop_back,
+    op_insert, op_remove, op_find, op_remove_value,
+    op_front, op_back, op_clear,
+    op_count
+};
+
+inline bool trace_op_has_value(trace_op op) {
+    return op == op_push_front || op == op_push_back || op == op_insert || op == op_find || op == op_remove_value;
+}
+
+inline bool trace_op_has_index(trace_op op) {
+    return op == op_insert || op == op_remove;
+}
+
+template<class V>
+int64_t trace_value(const V& val) {
+    if constexpr (std::is_arithmetic<V>::value || std::is_enum<V>::value) {
+        return static_cast<int64_t>(val);
+    } else {
+        return static_cast<int64_t>(std::hash<V>()(val));
+    }
+}
+
+// Buffered writer of one trace file, one per recorded container.
+class TraceWriter {
+    private:
+        FILE* file_;
+        std::vector<uint8_t> buffer_;
+        size_t ops_;
+
+        void put_varint(uint64_t);
+
+    public:
+        static const size_t buffer_size = size_t(1) << 16; // bytes buffered between writes
+        static const uint8_t version = 1;
+
+        explicit TraceWriter(const std::string&);         // create or truncate the trace file
+        ~TraceWriter();                                   // flush and close
+        TraceWriter(const TraceWriter&) = delete;
+        TraceWriter& operator=(const TraceWriter&) = delete;
+
+        void record(trace_op, int64_t = 0, size_t = 0);   // append one operation with its value and index
+        void flush();
+        size_t ops() const;                               // operations recorded so far
+};
+
+// Opt-in recorder: Recorded<SinglyLinkedList<int>> or Recorded<Stack<int>>
+// behaves like the wrapped container and logs every push / pop / insert /
+// remove / find / front / back / clear that succeeded to a TraceWriter.
+// Stack::push / pop / top are logged as push_front / pop_front / front.
+// Everything else (iterators, size, print...) is the container's own.
+template<class C>
+class Recorded : public C {
+    private:
+        TraceWriter* trace_;
+
+    public:
+        template<class... Args>
+        explicit Recorded(TraceWriter&, Args&&...);       // the arguments go to the container's constructor
+
+        template<class V> void push_front(V&&);
+        template<class V> void push_back(V&&);
+        template<class V> void push(V&&);
+        void pop_front();
+        void pop_back();
+        void pop();
+        template<class V, class I> void insert(V&&, I&&);
+        template<class I> void remove(I&&);
+        template<class V> size_t find(const V&);
+        template<class V> size_t find(const V&) const;
+        template<class V> size_t remove_value(const V&);
+        decltype(auto) front();
+        decltype(auto) back();
+        decltype(auto) top();
+        void clear();
+};
+
+inline TraceWriter::TraceWriter(const std::string& path) {
+    file_ = std::fopen(path.c_str(), "wb");
+    if (file_ == nullptr) {
+        throw std::runtime_error("cannot create the trace file");
+    }
+    buffer_.reserve(buffer_size + 32);
+    buffer_.insert(buffer_.end(), {'O', 'P', 'T', 'R', version});
+    ops_ = 0;
+}
+
+inline TraceWriter::~TraceWriter() {
+    flush();
+    std::fclose(file_);
+}
+
+inline void TraceWriter::put_varint(uint64_t x) {
+    while (x >= 0x80) {
+        buffer_.push_back(uint8_t(x) | 0x80);
+        x >>= 7;
+    }
+    buffer_.push_back(uint8_t(x));
+}
+
+inline void TraceWriter::record(trace_op op, int64_t value, size_t index) {
+    buffer_.push_back(op);
+    if (trace_op_has_value(op)) {
+        put_varint((uint64_t(value) << 1) ^ uint64_t(value >> 63));
+    }
+    if (trace_op_has_index(op)) {
+        put_varint(index);
+    }
+    ops_++;
+    if (buffer_.size() >= buffer_size) {
+        flush();
+    }
+}
+
+inline void TraceWriter::flush() {
+    if (!buffer_.empty()) {
+        std::fwrite(buffer_.data(), 1, buffer_.size(), file_);
+        buffer_.clear();
+    }
+    std::fflush(file_);
+}
+
+inline size_t TraceWriter::ops() const {
+    return ops_;
+}
+
+template<class C>
+template<class... Args>
+Recorded<C>::Recorded(TraceWriter& trace, Args&&... args) : C(std::forward<Args>(args)...), trace_(&trace) {}
+
+template<class C>
+template<class V>
+void Recorded<C>::push_front(V&& val) {
+    int64_t v = trace_value(val);
+    C::push_front(std::forward<V>(val));
+    trace_->record(op_push_front, v);
+}
+
+template<class C>
+template<class V>
+void Recorded<C>::push_back(V&& val) {
+    int64_t v = trace_value(val);
+    C::push_back(std::forward<V>(val));
+    trace_->record(op_push_back, v);
+}
+
+template<class C>
+template<class V>
+void Recorded<C>::push(V&& val) {
+    int64_t v = trace_value(val);
+    C::push(std::forward<V>(val));
+    trace_->record(op_push_front, v);
+}
+
+template<class C>
+void Recorded<C>::pop_front() {
+    C::pop_front();
+    trace_->record(op_pop_front);
+}
+
+template<class C>
+void Recorded<C>::pop_back() {
+    C::pop_back();
+    trace_->record(op_pop_back);
+}
+
+template<class C>
+void Recorded<C>::pop() {
+    C::pop();
+    trace_->record(op_pop_front);
+}
+
+template<class C>
+template<class V, class I>
+void Recorded<C>::insert(V&& val, I&& index) {
+    int64_t v = trace_value(val);
+    size_t i = index;
+    C::insert(std::forward<V>(val), std::forward<I>(index));
+    trace_->record(op_insert, v, i);
+}
+
+template<class C>
+template<class I>
+void Recorded<C>::remove(I&& index) {
+    size_t i = index;
+    C::remove(std::forward<I>(index));
+    trace_->record(op_remove, 0, i);
+}
+
+template<class C>
+template<class V>
+size_t Recorded<C>::find(const V& val) {
+    trace_->record(op_find, trace_value(val));
+    return C::find(val);
+}
+
+template<class C>
+template<class V>
+size_t Recorded<C>::find(const V& val) const {
+    trace_->record(op_find, trace_value(val));
+    return C::find(val);
+}
+
+template<class C>
+template<class V>
+size_t Recorded<C>::remove_value(const V& val) {
+    trace_->record(op_remove_value, trace_value(val));
+    return C::remove_value(val);
+}
+
+template<class C>
+decltype(auto) Recorded<C>::front() {
+    trace_->record(op_front);
+    return C::front();
+}
+
+template<class C>
+decltype(auto) Recorded<C>::back() {
+    trace_->record(op_back);
+    return C::back();
+}
+
+template<class C>
+decltype(auto) Recorded<C>::top() {
+    trace_->record(op_front);
+    return C::top();
+}
+
+template<class C>
+void Recorded<C>::clear() {
+    C::clear();
+    trace_->record(op_clear);
+}
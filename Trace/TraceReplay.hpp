@@ -0,0 +1,333 @@
+// file: TraceReplay.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "OpTrace.hpp"
+
+// Replays a trace written by TraceWriter against any container with int64_t
+// elements and reports throughput, allocations and per-operation latency.
+// Containers are driven through replay_adapter: the lists of this repository
+// and SpillStorage through their own member functions, std::list,
+// std::vector and std::deque through iterators. An op the container does not
+// have (pop_back on a Stack backing, say) marks the whole replay unsupported.
+// Allocations are read from replay_allocations(), which only counts when the
+// program replaces operator new to bump it, as replay.cpp does.
+
+struct trace_record {
+    trace_op op;
+    int64_t value;
+    size_t index;
+};
+
+struct replay_report {
+    std::string name;
+    bool supported;
+    size_t ops;
+    double seconds;                                       // whole trace, without per-op timing
+    size_t allocations;
+    double p50, p99, p999, max;                           // per-op latency in ns, clock overhead included
+    uint64_t checksum;                                    // of the find results and the elements read
+};
+
+inline std::atomic<size_t>& replay_allocations() {
+    static std::atomic<size_t> count(0);
+    return count;
+}
+
+inline std::vector<trace_record> load_trace(const std::string& path) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        throw std::runtime_error("cannot open the trace file");
+    }
+    std::vector<uint8_t> bytes;
+    uint8_t chunk[1 << 16];
+    size_t n;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), file)) != 0) {
+        bytes.insert(bytes.end(), chunk, chunk + n);
+    }
+    std::fclose(file);
+    if (bytes.size() < 5 || std::string(bytes.begin(), bytes.begin() + 4) != "OPTR" || bytes[4] != TraceWriter::version) {
+        throw std::runtime_error("not a trace file");
+    }
+
+    size_t pos = 5;
+    auto varint = [&bytes, &pos]() {
+        uint64_t x = 0;
+        for (unsigned shift = 0; ; shift += 7) {
+            if (pos == bytes.size() || shift > 63) {
+                throw std::runtime_error("truncated trace file");
+            }
+            uint8_t b = bytes[pos++];
+            x |= uint64_t(b & 0x7f) << shift;
+            if ((b & 0x80) == 0) {
+                return x;
+            }
+        }
+    };
+    std::vector<trace_record> trace;
+    while (pos < bytes.size()) {
+        trace_record r{trace_op(bytes[pos++]), 0, 0};
+        if (r.op >= op_count) {
+            throw std::runtime_error("unknown operation in the trace file");
+        }
+        if (trace_op_has_value(r.op)) {
+            uint64_t z = varint();
+            r.value = int64_t(z >> 1) ^ -int64_t(z & 1);
+        }
+        if (trace_op_has_index(r.op)) {
+            r.index = size_t(varint());
+        }
+        trace.push_back(r);
+    }
+    return trace;
+}
+
+// detection of the optional operations
+template<class C, class = void> struct has_push_back : std::false_type {};
+template<class C> struct has_push_back<C, std::void_t<decltype(std::declval<C&>().push_back(int64_t()))>> : std::true_type {};
+template<class C, class = void> struct has_pop_back : std::false_type {};
+template<class C> struct has_pop_back<C, std::void_t<decltype(std::declval<C&>().pop_back())>> : std::true_type {};
+template<class C, class = void> struct has_back : std::false_type {};
+template<class C> struct has_back<C, std::void_t<decltype(std::declval<C&>().back())>> : std::true_type {};
+template<class C, class = void> struct has_insert : std::false_type {};
+template<class C> struct has_insert<C, std::void_t<decltype(std::declval<C&>().insert(int64_t(), size_t()))>> : std::true_type {};
+template<class C, class = void> struct has_remove : std::false_type {};
+template<class C> struct has_remove<C, std::void_t<decltype(std::declval<C&>().remove(size_t()))>> : std::true_type {};
+template<class C, class = void> struct has_find : std::false_type {};
+template<class C> struct has_find<C, std::void_t<decltype(std::declval<C&>().find(int64_t()))>> : std::true_type {};
+template<class C, class = void> struct has_remove_value : std::false_type {};
+template<class C> struct has_remove_value<C, std::void_t<decltype(std::declval<C&>().remove_value(int64_t()))>> : std::true_type {};
+
+// Repository containers: push_front / pop_front / front / clear / size are
+// required, the rest is used when present. remove_value falls back to find
+// and remove. Ops on an empty container or out of range are skipped, the
+// recorder only logs operations that succeeded.
+template<class C>
+struct replay_adapter {
+    static bool supports(trace_op op) {
+        switch (op) {
+            case op_push_back: return has_push_back<C>::value;
+            case op_pop_back: return has_pop_back<C>::value;
+            case op_back: return has_back<C>::value;
+            case op_insert: return has_insert<C>::value;
+            case op_remove: return has_remove<C>::value;
+            case op_find: return has_find<C>::value;
+            case op_remove_value: return has_remove_value<C>::value || (has_find<C>::value && has_remove<C>::value);
+            default: return true;
+        }
+    }
+
+    static uint64_t apply(C& c, const trace_record& r) {
+        switch (r.op) {
+            case op_push_front:
+                c.push_front(r.value);
+                return 0;
+            case op_pop_front:
+                if (c.size() != 0) {
+                    c.pop_front();
+                }
+                return 0;
+            case op_front:
+                return (c.size() != 0) ? uint64_t(c.front()) : 0;
+            case op_clear:
+                c.clear();
+                return 0;
+            default:
+                break;
+        }
+        if constexpr (has_push_back<C>::value) {
+            if (r.op == op_push_back) {
+                c.push_back(r.value);
+            }
+        }
+        if constexpr (has_pop_back<C>::value) {
+            if (r.op == op_pop_back && c.size() != 0) {
+                c.pop_back();
+            }
+        }
+        if constexpr (has_back<C>::value) {
+            if (r.op == op_back) {
+                return (c.size() != 0) ? uint64_t(c.back()) : 0;
+            }
+        }
+        if constexpr (has_insert<C>::value) {
+            if (r.op == op_insert && r.index <= c.size()) {
+                c.insert(r.value, r.index);
+            }
+        }
+        if constexpr (has_remove<C>::value) {
+            if (r.op == op_remove && r.index < c.size()) {
+                c.remove(r.index);
+            }
+        }
+        if constexpr (has_find<C>::value) {
+            if (r.op == op_find) {
+                return uint64_t(c.find(r.value));
+            }
+        }
+        if constexpr (has_remove_value<C>::value) {
+            if (r.op == op_remove_value) {
+                return c.remove_value(r.value);
+            }
+        } else if constexpr (has_find<C>::value && has_remove<C>::value) {
+            if (r.op == op_remove_value) {
+                uint64_t count = 0;
+                for (size_t i = c.find(r.value); i != size_t(-1); i = c.find(r.value)) {
+                    c.remove(i);
+                    count++;
+                }
+                return count;
+            }
+        }
+        return 0;
+    }
+};
+
+// std::list, std::vector, std::deque
+template<class S>
+struct std_replay_adapter {
+    static bool supports(trace_op) {
+        return true;
+    }
+
+    static uint64_t apply(S& c, const trace_record& r) {
+        switch (r.op) {
+            case op_push_front:
+                c.insert(c.begin(), r.value);
+                return 0;
+            case op_push_back:
+                c.push_back(r.value);
+                return 0;
+            case op_pop_front:
+                if (!c.empty()) {
+                    c.erase(c.begin());
+                }
+                return 0;
+            case op_pop_back:
+                if (!c.empty()) {
+                    c.pop_back();
+                }
+                return 0;
+            case op_insert:
+                if (r.index <= c.size()) {
+                    c.insert(std::next(c.begin(), r.index), r.value);
+                }
+                return 0;
+            case op_remove:
+                if (r.index < c.size()) {
+                    c.erase(std::next(c.begin(), r.index));
+                }
+                return 0;
+            case op_find: {
+                auto it = std::find(c.begin(), c.end(), r.value);
+                return (it == c.end()) ? uint64_t(size_t(-1)) : uint64_t(std::distance(c.begin(), it));
+            }
+            case op_remove_value: {
+                size_t before = c.size();
+                c.erase(std::remove(c.begin(), c.end(), r.value), c.end());
+                return before - c.size();
+            }
+            case op_front:
+                return c.empty() ? 0 : uint64_t(c.front());
+            case op_back:
+                return c.empty() ? 0 : uint64_t(c.back());
+            case op_clear:
+                c.clear();
+                return 0;
+            default:
+                return 0;
+        }
+    }
+};
+
+template<> struct replay_adapter<std::list<int64_t>> : std_replay_adapter<std::list<int64_t>> {};
+template<> struct replay_adapter<std::vector<int64_t>> : std_replay_adapter<std::vector<int64_t>> {};
+template<> struct replay_adapter<std::deque<int64_t>> : std_replay_adapter<std::deque<int64_t>> {};
+
+// Runs the trace twice on fresh containers, set up by setup when given: once
+// untimed per op for the throughput and allocation count, once timing every op.
+template<class C>
+replay_report replay(const std::string& name, const std::vector<trace_record>& trace, void (*setup)(C&) = nullptr) {
+    typedef std::chrono::steady_clock clock;
+    replay_report report{name, true, trace.size(), 0, 0, 0, 0, 0, 0, 0};
+    for (const trace_record& r : trace) {
+        if (!replay_adapter<C>::supports(r.op)) {
+            report.supported = false;
+            return report;
+        }
+    }
+
+    {
+        C c;
+        if (setup != nullptr) {
+            setup(c);
+        }
+        size_t allocations = replay_allocations().load(std::memory_order_relaxed);
+        clock::time_point start = clock::now();
+        for (const trace_record& r : trace) {
+            report.checksum = report.checksum * 31 + replay_adapter<C>::apply(c, r);
+        }
+        report.seconds = std::chrono::duration<double>(clock::now() - start).count();
+        report.allocations = replay_allocations().load(std::memory_order_relaxed) - allocations;
+    }
+
+    std::vector<double> latency(trace.size());
+    {
+        C c;
+        if (setup != nullptr) {
+            setup(c);
+        }
+        uint64_t checksum = 0;
+        for (size_t i = 0; i < trace.size(); i++) {
+            clock::time_point start = clock::now();
+            checksum = checksum * 31 + replay_adapter<C>::apply(c, trace[i]);
+            latency[i] = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        }
+        if (checksum != report.checksum) {
+            throw std::logic_error("the two replays of " + name + " disagree");
+        }
+    }
+    if (!latency.empty()) {
+        std::sort(latency.begin(), latency.end());
+        report.p50 = latency[latency.size() / 2];
+        report.p99 = latency[latency.size() * 99 / 100];
+        report.p999 = latency[latency.size() * 999 / 1000];
+        report.max = latency.back();
+    }
+    return report;
+}
+
+inline void print_reports(std::ostream& out, const std::vector<replay_report>& reports) {
+    out << std::left << std::setw(28) << "container" << std::right
+        << std::setw(12) << "Mops/s" << std::setw(12) << "allocs"
+        << std::setw(10) << "p50 ns" << std::setw(10) << "p99 ns" << std::setw(11) << "p99.9 ns" << std::setw(12) << "max ns"
+        << "  checksum" << std::endl;
+    for (const replay_report& r : reports) {
+        out << std::left << std::setw(28) << r.name << std::right;
+        if (!r.supported) {
+            out << "  unsupported operation in the trace" << std::endl;
+            continue;
+        }
+        out << std::fixed << std::setprecision(2)
+            << std::setw(12) << ((r.seconds > 0) ? r.ops / r.seconds / 1e6 : 0.0)
+            << std::setw(12) << r.allocations << std::setprecision(0)
+            << std::setw(10) << r.p50 << std::setw(10) << r.p99 << std::setw(11) << r.p999 << std::setw(12) << r.max
+            << "  " << std::hex << r.checksum << std::dec << std::endl;
+    }
+}
@@ -0,0 +1,103 @@
+// file: bloom_bench.cpp
+//
+// Times find() with and without the membership summary (enable_summary(),
+// a CountingBloomFilter at a 1% false positive rate) on SinglyLinkedList and
+// DoublyLinkedList of 10000 ints, for query mixes where 0%, 50% and 99% of
+// the keys are absent:
+//
+//     g++ -std=c++17 -O2 bloom_bench.cpp -o bloom_bench
+//     ./bloom_bench [runs]
+//
+// A present key costs a walk to its position either way; an absent one costs
+// a full walk without the summary and, unless it is a false positive, one
+// filter probe with it. Each line is the median of the runs.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../LinkedList/SinglyLinkedList.hpp"
+#include "../LinkedList/DoublyLinkedLis.hpp"
+
+static const int list_size = 10000;
+static const int query_count = 20000;
+static const double false_positive_rate = 0.01;
+
+static int64_t sink = 0;                                  // keeps the results alive, printed at the end
+
+static double now_ms() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// the list holds the even numbers below 2 * list_size, the absent keys are odd
+static std::vector<int> queries(int miss_percent) {
+    std::mt19937 rng(unsigned(miss_percent + 1));
+    std::vector<int> out(query_count);
+    for (int& key : out) {
+        bool miss = int(rng() % 100) < miss_percent;
+        key = 2 * int(rng() % list_size) + (miss ? 1 : 0);
+    }
+    return out;
+}
+
+// nanoseconds per find(), median of the runs
+template<class List>
+double time_finds(const List& list, const std::vector<int>& keys, int runs) {
+    std::vector<double> times;
+    for (int r = 0; r < runs; r++) {
+        double start = now_ms();
+        size_t found = 0;
+        for (int key : keys) {
+            found += (list.find(key) != List::npos) ? 1 : 0;
+        }
+        times.push_back((now_ms() - start) * 1e6 / double(keys.size()));
+        sink += int64_t(found);
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+template<class List>
+void fill(List& list) {
+    for (int i = 0; i < list_size; i++) {
+        list.push_front(2 * i);
+    }
+}
+
+template<class List>
+void bench(const char* name, List& list, int runs) {
+    const List& view = list;                              // find() const, no reordering
+    int misses[] = { 0, 50, 99 };
+    for (int miss : misses) {
+        std::vector<int> keys = queries(miss);
+        list.disable_summary();
+        double plain = time_finds(view, keys, runs);
+        list.enable_summary(list_size, false_positive_rate);
+        double summarized = time_finds(view, keys, runs);
+        std::printf("%-18s %5d%% %14.0f %14.0f %8.1fx %9zu\n",
+                    name, miss, plain, summarized, plain / summarized, list.summary_bytes());
+    }
+}
+
+int main(int argc, char** argv) {
+    int runs = (argc > 1) ? std::atoi(argv[1]) : 5;
+    if (runs < 1) {
+        std::fprintf(stderr, "usage: %s [runs]\n", argv[0]);
+        return 2;
+    }
+    std::printf("%-18s %6s %14s %14s %9s %9s\n", "", "misses", "ns / find", "with summary", "speedup", "bytes");
+    // both lists are built before either is timed: a list built on the
+    // freed nodes of the other would get them back scattered in memory
+    SinglyLinkedList<int> singly;
+    DoublyLinkedList<int> doubly;
+    fill(singly);
+    fill(doubly);
+    bench("SinglyLinkedList", singly, runs);
+    bench("DoublyLinkedList", doubly, runs);
+    std::printf("checksum %lld\n", (long long)sink);
+    return 0;
+}
@@ -0,0 +1,110 @@
+// file: find_many_bench.cpp
+//
+// Times find_many() against one find() per key on a SinglyLinkedList of
+// n = 100000 distinct ints, for k = 1, 10, 100, 1000 and 10000 keys, half of
+// them in the list and half not. Both return the same indices, which is
+// checked once per k before anything is timed:
+//
+//     g++ -std=c++17 -O2 find_many_bench.cpp -o find_many_bench
+//     ./find_many_bench [runs] [n]
+//
+// The absent keys make every find() walk the whole list, and find_many()
+// walk it once; the present keys lie anywhere in the list.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../LinkedList/SinglyLinkedList.hpp"
+
+typedef SinglyLinkedList<int> List;
+
+static size_t n = 100000;                                 // list length, set from argv[2]
+
+static int64_t sink = 0;                                  // keeps the results alive, printed at the end
+
+static double now_ms() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static const List& list() {
+    static List l;
+    if (l.empty()) {
+        for (size_t i = 0; i < n; i++) {
+            l.push_front(int(2 * i));                     // even values, odd ones are absent
+        }
+    }
+    return l;
+}
+
+static std::vector<int> keys(size_t k) {
+    std::mt19937 rng(static_cast<unsigned>(k));
+    std::vector<int> out(k);
+    for (size_t i = 0; i < k; i++) {
+        out[i] = int(2 * (rng() % n) + (i & 1));
+    }
+    return out;
+}
+
+static std::vector<size_t> repeated_find(const List& l, const std::vector<int>& k) {
+    std::vector<size_t> out(k.size());
+    for (size_t i = 0; i < k.size(); i++) {
+        out[i] = l.find(k[i]);
+    }
+    return out;
+}
+
+static double time_find_many(const List& l, const std::vector<int>& k) {
+    double start = now_ms();
+    std::vector<size_t> found = l.find_many(k.data(), k.size());
+    double elapsed = now_ms() - start;
+    sink += int64_t(found.back());
+    return elapsed;
+}
+
+static double time_repeated_find(const List& l, const std::vector<int>& k) {
+    double start = now_ms();
+    std::vector<size_t> found = repeated_find(l, k);
+    double elapsed = now_ms() - start;
+    sink += int64_t(found.back());
+    return elapsed;
+}
+
+static double median(std::vector<double> times) {
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+int main(int argc, char** argv) {
+    int runs = (argc > 1) ? std::atoi(argv[1]) : 5;
+    long size = (argc > 2) ? std::atol(argv[2]) : 100000;
+    if (runs < 1 || size < 1) {
+        std::fprintf(stderr, "usage: %s [runs] [n]\n", argv[0]);
+        return 2;
+    }
+    n = size_t(size);
+    const List& l = list();
+    std::printf("%-8s %18s %18s %10s\n", "keys", "find_many ms", "repeated find ms", "speedup");
+    for (size_t k = 1; k <= 10000; k *= 10) {
+        std::vector<int> q = keys(k);
+        if (l.find_many(q.data(), q.size()) != repeated_find(l, q)) {
+            std::fprintf(stderr, "find_many and find disagree for %zu keys\n", k);
+            return 1;
+        }
+        std::vector<double> many;
+        std::vector<double> repeated;
+        for (int r = 0; r < runs; r++) {
+            many.push_back(time_find_many(l, q));
+            repeated.push_back(time_repeated_find(l, q));
+        }
+        double m = median(many);
+        double f = median(repeated);
+        std::printf("%-8zu %18.3f %18.3f %9.1fx\n", k, m, f, f / m);
+    }
+    std::printf("checksum %lld\n", (long long)sink);
+    return 0;
+}
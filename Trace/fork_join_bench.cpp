@@ -0,0 +1,133 @@
+// file: fork_join_bench.cpp
+//
+// Strong scaling of TaskScheduler / TaskGroup on two fork-join kernels, from
+// 1 worker up to the number of cores (or the count given), doubling:
+//
+//     fib         recursive fib(36), one child spawned per call above
+//                 fib(20), the rest computed serially
+//     sum         recursive halving sum of 32M ints, leaves of 64K
+//
+//     g++ -std=c++17 -O2 -pthread fork_join_bench.cpp -o fork_join_bench
+//     ./fork_join_bench [runs] [max workers]
+//
+// The serial line is the same recursion without a scheduler; speedup is the
+// serial median over the median with that many workers.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "../WorkStealing/TaskScheduler.hpp"
+
+static const int fib_n = 36;
+static const int fib_cutoff = 20;                         // below this fib() does not spawn
+static const size_t sum_size = size_t(32) << 20;
+static const size_t sum_grain = size_t(64) << 10;         // ints summed by one leaf
+
+static int64_t sink = 0;                                  // keeps the results alive, printed at the end
+
+static double now_ms() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static int64_t fib_serial(int n) {
+    return (n < 2) ? n : fib_serial(n - 1) + fib_serial(n - 2);
+}
+
+static int64_t fib(TaskScheduler& scheduler, int n) {
+    if (n < fib_cutoff) {
+        return fib_serial(n);
+    }
+    int64_t a = 0;
+    TaskGroup group(scheduler);
+    group.run([&scheduler, &a, n] { a = fib(scheduler, n - 1); });
+    int64_t b = fib(scheduler, n - 2);
+    group.wait();
+    return a + b;
+}
+
+static int64_t sum_serial(const int* first, size_t count) {
+    int64_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        total += first[i];
+    }
+    return total;
+}
+
+static int64_t sum(TaskScheduler& scheduler, const int* first, size_t count) {
+    if (count <= sum_grain) {
+        return sum_serial(first, count);
+    }
+    size_t half = count / 2;
+    int64_t left = 0;
+    TaskGroup group(scheduler);
+    group.run([&scheduler, &left, first, half] { left = sum(scheduler, first, half); });
+    int64_t right = sum(scheduler, first + half, count - half);
+    group.wait();
+    return left + right;
+}
+
+static const std::vector<int>& data() {
+    static std::vector<int> d;
+    if (d.empty()) {
+        d.resize(sum_size);
+        for (size_t i = 0; i < sum_size; i++) {
+            d[i] = int(i % 1000);
+        }
+    }
+    return d;
+}
+
+// times of every run on one scheduler, the scheduler is not created in the timed part
+template<class Fn>
+double median_ms(int runs, Fn fn) {
+    std::vector<double> times;
+    for (int r = 0; r < runs; r++) {
+        double start = now_ms();
+        sink += fn();
+        times.push_back(now_ms() - start);
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+int main(int argc, char** argv) {
+    int runs = (argc > 1) ? std::atoi(argv[1]) : 5;
+    size_t cores = std::max<size_t>(1, std::thread::hardware_concurrency());
+    long max_workers = (argc > 2) ? std::atol(argv[2]) : long(cores);
+    if (runs < 1 || max_workers < 1) {
+        std::fprintf(stderr, "usage: %s [runs] [max workers]\n", argv[0]);
+        return 2;
+    }
+    const std::vector<int>& d = data();
+    if (fib_serial(25) != 75025) {
+        return 1;
+    }
+    double fib_base = median_ms(runs, [] { return fib_serial(fib_n); });
+    double sum_base = median_ms(runs, [&d] { return sum_serial(d.data(), d.size()); });
+    std::printf("%-8s %14s %8s %14s %8s\n", "workers", "fib ms", "speedup", "sum ms", "speedup");
+    std::printf("%-8s %14.2f %8s %14.2f %8s\n", "serial", fib_base, "1.00", sum_base, "1.00");
+    std::vector<size_t> counts;
+    for (size_t w = 1; w < size_t(max_workers); w *= 2) {
+        counts.push_back(w);
+    }
+    counts.push_back(size_t(max_workers));
+    for (size_t w : counts) {
+        TaskScheduler scheduler(w);
+        int64_t expected_fib = fib_serial(fib_n);
+        int64_t expected_sum = sum_serial(d.data(), d.size());
+        if (fib(scheduler, fib_n) != expected_fib || sum(scheduler, d.data(), d.size()) != expected_sum) {
+            std::fprintf(stderr, "wrong result with %zu workers\n", w);
+            return 1;
+        }
+        double f = median_ms(runs, [&scheduler] { return fib(scheduler, fib_n); });
+        double s = median_ms(runs, [&scheduler, &d] { return sum(scheduler, d.data(), d.size()); });
+        std::printf("%-8zu %14.2f %8.2f %14.2f %8.2f\n", w, f, fib_base / f, s, sum_base / s);
+    }
+    std::printf("checksum %lld\n", (long long)sink);
+    return 0;
+}
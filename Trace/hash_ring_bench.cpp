@@ -0,0 +1,131 @@
+// file: hash_ring_bench.cpp
+//
+// Times key -> owner lookups on a ConsistentHashRing of 1000 members with 100
+// virtual nodes each, against the walk it replaces: the virtual nodes in point
+// order in a CircularLinkedList, turned with advance() until the cursor passes
+// the key's point. Prints the median and the fastest of several runs:
+//
+//     g++ -std=c++17 -O2 hash_ring_bench.cpp -o hash_ring_bench
+//     ./hash_ring_bench [runs]
+//
+// The walk starts where the previous lookup left the cursor, so a random key
+// costs about half the ring, 50K links.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../LinkedList/ConsistentHashRing.hpp"
+
+typedef ConsistentHashRing<int, std::hash<int>> Ring;
+
+static const int member_count = 1000;
+static const size_t replicas = 100;                       // 100K virtual nodes in all
+static const int owner_count = 1000000;                   // owner() lookups per run
+static const int walk_count = 2000;                       // advance() walks per run
+
+static int64_t sink = 0;                                  // keeps the results alive, printed at the end
+
+static double now_ms() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static const Ring& ring() {
+    static Ring r(replicas);
+    if (r.empty()) {
+        for (int m = 0; m < member_count; m++) {
+            r.add(m);
+        }
+    }
+    return r;
+}
+
+// the ring as it was kept before: a copy of the virtual nodes whose cursor
+// stays where the last lookup put it
+static CircularLinkedList<Ring::vnode>& walk_ring() {
+    static CircularLinkedList<Ring::vnode> list;
+    if (list.empty()) {
+        for (const Ring::vnode& v : ring().ring()) {
+            list.push_back(v);
+        }
+    }
+    return list;
+}
+
+// advance() until the point falls in (back, front], the wrap included
+static int walk_owner(CircularLinkedList<Ring::vnode>& list, uint64_t point) {
+    for (size_t i = 0; i < list.size(); i++) {
+        uint64_t low = list.back().point;
+        uint64_t high = list.front().point;
+        bool inside = (low < high) ? (low < point && point <= high) : (low < point || point <= high);
+        if (inside) {
+            return list.front().owner;
+        }
+        list.advance();
+    }
+    return list.front().owner;                            // a single virtual node owns everything
+}
+
+static std::vector<int> keys(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<int> out(count);
+    for (size_t i = 0; i < count; i++) {
+        out[i] = int(rng());
+    }
+    return out;
+}
+
+static double owner_run() {
+    static const std::vector<int> k = keys(owner_count, 1);
+    const Ring& r = ring();
+    double start = now_ms();
+    for (int key : k) {
+        sink += r.owner(key);
+    }
+    return now_ms() - start;
+}
+
+static double walk_run() {
+    static const std::vector<int> k = keys(walk_count, 2);
+    CircularLinkedList<Ring::vnode>& list = walk_ring();
+    double start = now_ms();
+    for (int key : k) {
+        sink += walk_owner(list, Ring::point_of(key));
+    }
+    return now_ms() - start;
+}
+
+static void report(const char* name, int lookups, double (*run)(), int runs) {
+    std::vector<double> times;
+    for (int r = 0; r < runs; r++) {
+        times.push_back(run());
+    }
+    std::sort(times.begin(), times.end());
+    std::printf("%-22s %8d lookups   median %9.2f ms   min %9.2f ms   %10.1f ns / lookup\n",
+                name, lookups, times[times.size() / 2], times[0], times[times.size() / 2] * 1e6 / lookups);
+}
+
+int main(int argc, char** argv) {
+    int runs = (argc > 1) ? std::atoi(argv[1]) : 9;
+    if (runs < 1) {
+        std::fprintf(stderr, "usage: %s [runs]\n", argv[0]);
+        return 2;
+    }
+    const Ring& r = ring();
+    std::vector<int> check = keys(1000, 3);               // both answer the same before anything is timed
+    for (int key : check) {
+        if (walk_owner(walk_ring(), Ring::point_of(key)) != r.owner(key)) {
+            std::fprintf(stderr, "walk and owner() disagree on key %d\n", key);
+            return 1;
+        }
+    }
+    std::printf("%d members, %zu virtual nodes\n", int(r.members()), r.size());
+    report("owner() side index", owner_count, &owner_run, runs);
+    report("advance() walk", walk_count, &walk_run, runs);
+    std::printf("checksum %lld\n", (long long)sink);
+    return 0;
+}
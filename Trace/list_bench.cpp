@@ -0,0 +1,165 @@
+// file: list_bench.cpp
+//
+// Times the basic operations of SinglyLinkedList, DoublyLinkedList and
+// CircularLinkedList and prints the median and the fastest of several runs of
+// each, one line per operation:
+//
+//     g++ -std=c++17 -O2 list_bench.cpp -o list_bench
+//     ./list_bench [runs]
+//
+// It only uses the API the lists had before they became aliases of
+// list_core::list, so the same file builds against an older tree for a before
+// and after comparison. The older headers each define a global Node, so pick
+// one list per binary there with -DBENCH_SINGLY, -DBENCH_DOUBLY or
+// -DBENCH_CIRCULAR:
+//
+//     git worktree add /tmp/before <commit>
+//     cp list_bench.cpp /tmp/before/Trace/
+//     g++ -std=c++17 -O2 -DBENCH_SINGLY /tmp/before/Trace/list_bench.cpp -o before_singly
+//
+// Run the binaries one after the other on a quiet machine; single runs differ
+// by 10% or more, the median of several is what to compare.
+
+#if !defined(BENCH_SINGLY) && !defined(BENCH_DOUBLY) && !defined(BENCH_CIRCULAR)
+#define BENCH_SINGLY
+#define BENCH_DOUBLY
+#define BENCH_CIRCULAR
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#ifdef BENCH_SINGLY
+#include "../LinkedList/SinglyLinkedList.hpp"
+#endif
+#ifdef BENCH_DOUBLY
+#include "../LinkedList/DoublyLinkedLis.hpp"
+#endif
+#ifdef BENCH_CIRCULAR
+#include "../LinkedList/CircularLinkedList.hpp"
+#endif
+
+static const int front_count = 1000000;                   // push_front / pop_front
+static const int back_count = 10000;                      // push_back, O(n) each in the old SinglyLinkedList
+static const int search_size = 5000;                      // list length for find and the index operations
+static const int search_count = 5000;                     // find() calls, about half of them hits
+static const int index_count = 10000;                     // insert() and remove() pairs
+
+static int64_t sink = 0;                                  // keeps the results alive, printed at the end
+
+static double now_ms() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// one timed run; setup and teardown are not timed, the list is destroyed after
+template<class List>
+double push_front_run() {
+    List list;
+    double start = now_ms();
+    for (int i = 0; i < front_count; i++) {
+        list.push_front(i);
+    }
+    double elapsed = now_ms() - start;
+    sink += int64_t(list.size());
+    return elapsed;
+}
+
+template<class List>
+double pop_front_run() {
+    List list;
+    for (int i = 0; i < front_count; i++) {
+        list.push_front(i);
+    }
+    double start = now_ms();
+    while (!list.empty()) {
+        sink += *list.begin();
+        list.pop_front();
+    }
+    return now_ms() - start;
+}
+
+template<class List>
+double push_back_run() {
+    List list;
+    double start = now_ms();
+    for (int i = 0; i < back_count; i++) {
+        list.push_back(i);
+    }
+    double elapsed = now_ms() - start;
+    sink += int64_t(list.size());
+    return elapsed;
+}
+
+template<class List>
+double find_run() {
+    List list;
+    for (int i = 0; i < search_size; i++) {
+        list.push_front(i);
+    }
+    const List& view = list;                              // find() const, no reordering
+    std::mt19937 rng(1);
+    double start = now_ms();
+    for (int i = 0; i < search_count; i++) {
+        sink += int64_t(view.find(int(rng() % (2 * search_size))));
+    }
+    return now_ms() - start;
+}
+
+template<class List>
+double index_run() {
+    List list;
+    for (int i = 0; i < search_size; i++) {
+        list.push_front(i);
+    }
+    std::mt19937 rng(2);
+    double start = now_ms();
+    for (int i = 0; i < index_count; i++) {
+        list.insert(i, size_t(rng() % (list.size() + 1)));
+        list.remove(size_t(rng() % list.size()));
+    }
+    double elapsed = now_ms() - start;
+    sink += int64_t(list.size());
+    return elapsed;
+}
+
+static void report(const char* name, const char* operation, double (*run)(), int runs) {
+    std::vector<double> times;
+    for (int r = 0; r < runs; r++) {
+        times.push_back(run());
+    }
+    std::sort(times.begin(), times.end());
+    std::printf("%-20s %-18s median %9.2f ms   min %9.2f ms\n", name, operation, times[times.size() / 2], times[0]);
+}
+
+template<class List>
+void bench(const char* name, int runs) {
+    report(name, "push_front 1M", &push_front_run<List>, runs);
+    report(name, "pop_front 1M", &pop_front_run<List>, runs);
+    report(name, "push_back 10k", &push_back_run<List>, runs);
+    report(name, "find 5k in 5k", &find_run<List>, runs);
+    report(name, "insert+remove 10k", &index_run<List>, runs);
+}
+
+int main(int argc, char** argv) {
+    int runs = (argc > 1) ? std::atoi(argv[1]) : 9;
+    if (runs < 1) {
+        std::fprintf(stderr, "usage: %s [runs]\n", argv[0]);
+        return 2;
+    }
+#ifdef BENCH_SINGLY
+    bench<SinglyLinkedList<int>>("SinglyLinkedList", runs);
+#endif
+#ifdef BENCH_DOUBLY
+    bench<DoublyLinkedList<int>>("DoublyLinkedList", runs);
+#endif
+#ifdef BENCH_CIRCULAR
+    bench<CircularLinkedList<int>>("CircularLinkedList", runs);
+#endif
+    std::printf("checksum %lld\n", (long long)sink);
+    return 0;
+}
@@ -0,0 +1,120 @@
+// file: parallel_list_bench.cpp
+//
+// Strong scaling of the ParallelList algorithms on a list of 4M ints, from 1
+// worker up to the number of cores (or the count given), doubling:
+//
+//     reduce      parallel_reduce, a plain sum, bound by walking the nodes
+//     for_each    parallel_for_each with a few dozen multiply / shift
+//                 rounds per element, bound by computation
+//
+//     g++ -std=c++17 -O2 -pthread parallel_list_bench.cpp -o parallel_list_bench
+//     ./parallel_list_bench [runs] [max workers]
+//
+// Both run on the default SinglyLinkedList, whose segments() walks the list
+// on the calling thread first, and on a list built with segment_checkpoints,
+// which has the cut points ready. The serial line is the same loop over the
+// list without a scheduler; speedup is the serial median over the median
+// with that many workers.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "../LinkedList/SinglyLinkedList.hpp"
+#include "../LinkedList/ParallelList.hpp"
+
+typedef list_core::list<int, list_core::single_link, static_order, list_core::hook_allocator,
+                        list_core::tracked_size, list_core::no_instrument, list_core::segment_checkpoints> CheckpointedList;
+
+static const int list_size = 4 << 20;
+static const int mix_rounds = 32;                         // work per element in for_each
+
+static int64_t sink = 0;                                  // keeps the results alive, printed at the end
+
+static double now_ms() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void mix(int& x) {
+    uint32_t v = uint32_t(x);
+    for (int r = 0; r < mix_rounds; r++) {
+        v = (v ^ (v >> 15)) * 2654435761u;
+    }
+    x = int(v & 0xffff);
+}
+
+template<class Fn>
+double median_ms(int runs, Fn fn) {
+    std::vector<double> times;
+    for (int r = 0; r < runs; r++) {
+        double start = now_ms();
+        fn();
+        times.push_back(now_ms() - start);
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+template<class List>
+void bench(const char* name, int runs, const std::vector<size_t>& counts) {
+    List list;
+    for (int i = 0; i < list_size; i++) {
+        list.push_front(i & 0xffff);
+    }
+    double reduce_base = median_ms(runs, [&list] {
+        int64_t total = 0;
+        for (int x : list) {
+            total += x;
+        }
+        sink += total;
+    });
+    double each_base = median_ms(runs, [&list] {
+        for (int& x : list) {
+            mix(x);
+        }
+    });
+    std::printf("%s\n", name);
+    std::printf("  %-8s %12s %8s %12s %8s\n", "workers", "reduce ms", "speedup", "for_each ms", "speedup");
+    std::printf("  %-8s %12.2f %8s %12.2f %8s\n", "serial", reduce_base, "1.00", each_base, "1.00");
+    for (size_t w : counts) {
+        TaskScheduler scheduler(w);
+        int64_t expected = 0;
+        for (int x : list) {
+            expected += x;
+        }
+        if (parallel_reduce(scheduler, list, int64_t(0), [](int64_t a, int64_t b) { return a + b; }) != expected) {
+            std::fprintf(stderr, "%s: wrong sum with %zu workers\n", name, w);
+            std::exit(1);
+        }
+        double reduce = median_ms(runs, [&scheduler, &list] {
+            sink += parallel_reduce(scheduler, list, int64_t(0), [](int64_t a, int64_t b) { return a + b; });
+        });
+        double each = median_ms(runs, [&scheduler, &list] {
+            parallel_for_each(scheduler, list, [](int& x) { mix(x); });
+        });
+        std::printf("  %-8zu %12.2f %8.2f %12.2f %8.2f\n", w, reduce, reduce_base / reduce, each, each_base / each);
+    }
+}
+
+int main(int argc, char** argv) {
+    int runs = (argc > 1) ? std::atoi(argv[1]) : 5;
+    size_t cores = std::max<size_t>(1, std::thread::hardware_concurrency());
+    long max_workers = (argc > 2) ? std::atol(argv[2]) : long(cores);
+    if (runs < 1 || max_workers < 1) {
+        std::fprintf(stderr, "usage: %s [runs] [max workers]\n", argv[0]);
+        return 2;
+    }
+    std::vector<size_t> counts;
+    for (size_t w = 1; w < size_t(max_workers); w *= 2) {
+        counts.push_back(w);
+    }
+    counts.push_back(size_t(max_workers));
+    bench<SinglyLinkedList<int>>("SinglyLinkedList, segments() walks", runs, counts);
+    bench<CheckpointedList>("segment_checkpoints", runs, counts);
+    std::printf("checksum %lld\n", (long long)sink);
+    return 0;
+}
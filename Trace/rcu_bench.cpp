@@ -0,0 +1,179 @@
+// file: rcu_bench.cpp
+//
+// Read scaling of RcuLinkedList with a background writer, next to the
+// std::shared_mutex + DoublyLinkedList it replaces. A list of 1000 ints is
+// searched by 1, 2, 4, ... reader threads (up to the number of cores, or the
+// count given) while one writer keeps replacing random elements, one update
+// every 100 us. Every configuration runs for half a second:
+//
+//     g++ -std=c++17 -O2 -pthread rcu_bench.cpp -o rcu_bench
+//     ./rcu_bench [runs] [max readers]
+//
+// Each line is the median of the runs: finds per second by all readers
+// together, per reader, and the updates the writer got through. The readers
+// stop on their own at the deadline: a std::shared_mutex may let a stream of
+// readers starve the writer, which then only gets in once they are done.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+#include "../LinkedList/DoublyLinkedLis.hpp"
+#include "../LinkedList/RcuLinkedList.hpp"
+
+static const int list_size = 1000;
+static const std::chrono::milliseconds duration(500);
+static const std::chrono::microseconds write_interval(100);
+
+static std::atomic<int64_t> sink(0);                      // keeps the results alive, printed at the end
+
+struct result {
+    double finds;                                         // finds per second, all readers
+    double writes;                                        // updates per second
+};
+
+// the list with its lock, as the routing tables keep it today
+struct locked_list {
+    std::shared_mutex lock;
+    DoublyLinkedList<int> list;
+};
+
+static void fill(RcuLinkedList<int>& list) {
+    for (int i = 0; i < list_size; i++) {
+        list.push_back(2 * i);
+    }
+}
+
+static void fill(locked_list& l) {
+    for (int i = 0; i < list_size; i++) {
+        l.list.push_back(2 * i);
+    }
+}
+
+static void update(RcuLinkedList<int>& list, size_t index, int value) {
+    list.replace(value, index);
+}
+
+static void update(locked_list& l, size_t index, int value) {
+    std::unique_lock<std::shared_mutex> guard(l.lock);
+    l.list.remove(index);
+    l.list.insert(value, index);
+}
+
+static result run_rcu(size_t readers) {
+    RcuLinkedList<int> list;
+    fill(list);
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + duration;
+    std::atomic<int64_t> finds(0);
+    int64_t writes = 0;
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < readers; t++) {
+        threads.emplace_back([&list, deadline, &finds, t] {
+            RcuLinkedList<int>::reader r(list);
+            std::mt19937 rng(unsigned(t + 1));
+            int64_t done = 0;
+            int64_t found = 0;
+            while ((done & 63) != 0 || std::chrono::steady_clock::now() < deadline) {
+                found += (r.find(int(rng() % (2 * list_size))) != RcuLinkedList<int>::npos) ? 1 : 0;
+                done++;
+            }
+            finds += done;
+            sink += found;
+        });
+    }
+    std::mt19937 rng(0);
+    while (std::chrono::steady_clock::now() < deadline) {
+        update(list, size_t(rng() % list_size), 2 * int(rng() % list_size));
+        writes++;
+        std::this_thread::sleep_for(write_interval);
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result{double(finds.load()) / seconds, double(writes) / seconds};
+}
+
+static result run_locked(size_t readers) {
+    locked_list l;
+    fill(l);
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + duration;
+    std::atomic<int64_t> finds(0);
+    int64_t writes = 0;
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < readers; t++) {
+        threads.emplace_back([&l, deadline, &finds, t] {
+            const DoublyLinkedList<int>& view = l.list;
+            std::mt19937 rng(unsigned(t + 1));
+            int64_t done = 0;
+            int64_t found = 0;
+            while ((done & 63) != 0 || std::chrono::steady_clock::now() < deadline) {
+                int value = int(rng() % (2 * list_size));
+                std::shared_lock<std::shared_mutex> guard(l.lock);
+                found += (view.find(value) != DoublyLinkedList<int>::npos) ? 1 : 0;
+                done++;
+            }
+            finds += done;
+            sink += found;
+        });
+    }
+    std::mt19937 rng(0);
+    while (std::chrono::steady_clock::now() < deadline) {
+        update(l, size_t(rng() % list_size), 2 * int(rng() % list_size));
+        writes++;
+        std::this_thread::sleep_for(write_interval);
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result{double(finds.load()) / seconds, double(writes) / seconds};
+}
+
+static void report(const char* name, size_t readers, result (*run)(size_t), int runs) {
+    std::vector<double> finds;
+    std::vector<double> writes;
+    for (int r = 0; r < runs; r++) {
+        result res = run(readers);
+        finds.push_back(res.finds);
+        writes.push_back(res.writes);
+    }
+    std::sort(finds.begin(), finds.end());
+    std::sort(writes.begin(), writes.end());
+    double f = finds[finds.size() / 2];
+    std::printf("%-22s %7zu %14.0f %14.0f %10.0f\n", name, readers, f, f / double(readers), writes[writes.size() / 2]);
+}
+
+int main(int argc, char** argv) {
+    int runs = (argc > 1) ? std::atoi(argv[1]) : 3;
+    size_t cores = std::max<size_t>(1, std::thread::hardware_concurrency());
+    long max_readers = (argc > 2) ? std::atol(argv[2]) : long(cores);
+    if (runs < 1 || max_readers < 1) {
+        std::fprintf(stderr, "usage: %s [runs] [max readers]\n", argv[0]);
+        return 2;
+    }
+    std::vector<size_t> counts;
+    for (size_t r = 1; r < size_t(max_readers); r *= 2) {
+        counts.push_back(r);
+    }
+    counts.push_back(size_t(max_readers));
+    std::printf("%-22s %7s %14s %14s %10s\n", "", "readers", "finds / s", "per reader", "writes / s");
+    for (size_t r : counts) {
+        report("RcuLinkedList", r, &run_rcu, runs);
+    }
+    for (size_t r : counts) {
+        report("shared_mutex + list", r, &run_locked, runs);
+    }
+    std::printf("checksum %lld\n", (long long)sink.load());
+    return 0;
+}
@@ -0,0 +1,84 @@
+// file: replay.cpp
+//
+// Replays a trace recorded with Recorded<...> (OpTrace.hpp) against every
+// container and prints one line per container:
+//
+//     g++ -std=c++17 -O2 -pthread replay.cpp -o replay
+//     ./replay trace.bin
+//
+// Stack is covered by its backings, SinglyLinkedList and SpillStorage.
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <list>
+#include <new>
+#include <vector>
+#include "TraceReplay.hpp"
+#include "../LinkedList/CircularLinkedList.hpp"
+#include "../LinkedList/DoublyCircularLinkedList.hpp"
+#include "../LinkedList/DoublyLinkedLis.hpp"
+#include "../LinkedList/PoolDoublyLinkedList.hpp"
+#include "../LinkedList/PoolSinglyLinkedList.hpp"
+#include "../LinkedList/SinglyLinkedList.hpp"
+#include "../LinkedList/XorLinkedList.hpp"
+#include "../Stack/SpillStorage.hpp"
+
+void* operator new(size_t size) {
+    replay_allocations().fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+static void with_summary(DoublyLinkedList<int64_t>& list) {
+    list.enable_summary(1024);
+}
+
+static void background_reclaim(DoublyLinkedList<int64_t>& list) {
+    list.set_reclaim_mode(reclaim_background);
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::cerr << "usage: " << argv[0] << " trace-file" << std::endl;
+        return 2;
+    }
+    try {
+        std::vector<trace_record> trace = load_trace(argv[1]);
+        std::cout << trace.size() << " operations" << std::endl;
+
+        std::vector<replay_report> reports;
+        reports.push_back(replay<SinglyLinkedList<int64_t>>("SinglyLinkedList", trace));
+        reports.push_back(replay<DoublyLinkedList<int64_t>>("DoublyLinkedList", trace));
+        reports.push_back(replay<DoublyLinkedList<int64_t, move_to_front_order>>("Doubly, move_to_front", trace));
+        reports.push_back(replay<DoublyLinkedList<int64_t>>("Doubly, summary", trace, &with_summary));
+        reports.push_back(replay<DoublyLinkedList<int64_t>>("Doubly, background reclaim", trace, &background_reclaim));
+        reports.push_back(replay<CircularLinkedList<int64_t>>("CircularLinkedList", trace));
+        reports.push_back(replay<DoublyCircularLinkedList<int64_t>>("DoublyCircularLinkedList", trace));
+        reports.push_back(replay<XorLinkedList<int64_t>>("XorLinkedList", trace));
+        reports.push_back(replay<PoolSinglyLinkedList<int64_t>>("PoolSinglyLinkedList", trace));
+        reports.push_back(replay<PoolDoublyLinkedList<int64_t>>("PoolDoublyLinkedList", trace));
+        reports.push_back(replay<SpillStorage<int64_t>>("SpillStorage", trace));
+        reports.push_back(replay<std::list<int64_t>>("std::list", trace));
+        reports.push_back(replay<std::vector<int64_t>>("std::vector", trace));
+        reports.push_back(replay<std::deque<int64_t>>("std::deque", trace));
+        print_reports(std::cout, reports);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,150 @@
+// file: spill_bench.cpp
+//
+// Times a Stack backed by SpillStorage on stacks 10 times larger than its
+// memory budget, next to the default SinglyLinkedList backing holding the
+// same stack in memory. Three workloads, each from an empty stack:
+//
+//     push     push 10 x budget worth of 8-byte states
+//     pop      pop them all again, checking the order
+//     dfs      random walk of pushes and pops drifting to the same depth,
+//              the shape of a depth-first search
+//
+//     g++ -std=c++17 -O2 spill_bench.cpp -o spill_bench
+//     ./spill_bench [runs] [budget MiB]
+//
+// The spill file is a tmpfile(), so the numbers depend on the file system
+// behind /tmp and on how much of it the page cache absorbs. The first line
+// printed shows how much of a full stack sits in the file.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../Stack/stack.hpp"
+
+typedef SpillStorage<uint64_t> Spill;
+
+static size_t budget_bytes = size_t(16) << 20;            // SpillStorage memory budget, set from argv[2]
+static const size_t block_bytes = size_t(1) << 20;
+static const size_t oversize = 10;                        // stack size / budget
+
+static int64_t sink = 0;                                  // keeps the results alive, printed at the end
+
+static double now_ms() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static size_t state_count() {
+    return oversize * budget_bytes / sizeof(uint64_t);
+}
+
+template<class Backing>
+static Stack<uint64_t, Backing> make_stack();
+
+template<>
+Stack<uint64_t, Spill> make_stack<Spill>() {
+    return Stack<uint64_t, Spill>(Spill(budget_bytes, block_bytes));
+}
+
+template<>
+Stack<uint64_t, SinglyLinkedList<uint64_t>> make_stack<SinglyLinkedList<uint64_t>>() {
+    return Stack<uint64_t, SinglyLinkedList<uint64_t>>();
+}
+
+template<class Backing>
+double push_run() {
+    Stack<uint64_t, Backing> stack = make_stack<Backing>();
+    size_t count = state_count();
+    double start = now_ms();
+    for (size_t i = 0; i < count; i++) {
+        stack.push(uint64_t(i));
+    }
+    double elapsed = now_ms() - start;
+    sink += int64_t(stack.size());
+    return elapsed;
+}
+
+template<class Backing>
+double pop_run() {
+    Stack<uint64_t, Backing> stack = make_stack<Backing>();
+    size_t count = state_count();
+    for (size_t i = 0; i < count; i++) {
+        stack.push(uint64_t(i));
+    }
+    double start = now_ms();
+    for (size_t i = count; i-- > 0;) {
+        if (stack.top() != i) {
+            std::fprintf(stderr, "popped %llu, expected %llu\n", (unsigned long long)stack.top(), (unsigned long long)i);
+            std::exit(1);
+        }
+        stack.pop();
+    }
+    double elapsed = now_ms() - start;
+    sink += int64_t(stack.size());
+    return elapsed;
+}
+
+template<class Backing>
+double dfs_run() {
+    Stack<uint64_t, Backing> stack = make_stack<Backing>();
+    size_t count = state_count();
+    std::mt19937_64 rng(1);
+    double start = now_ms();
+    for (size_t i = 0; i < 2 * count; i++) {              // 3 pushes to 1 pop ends about count deep
+        if ((rng() & 3) != 0 || stack.empty()) {
+            stack.push(uint64_t(i));
+        } else {
+            sink += int64_t(stack.top());
+            stack.pop();
+        }
+    }
+    double elapsed = now_ms() - start;
+    sink += int64_t(stack.size());
+    return elapsed;
+}
+
+static void report(const char* name, const char* workload, double (*run)(), int runs) {
+    std::vector<double> times;
+    for (int r = 0; r < runs; r++) {
+        times.push_back(run());
+    }
+    std::sort(times.begin(), times.end());
+    double mib = double(state_count() * sizeof(uint64_t)) / double(1 << 20);
+    std::printf("%-20s %-6s median %9.2f ms   min %9.2f ms   %7.1f MiB/s\n",
+                name, workload, times[times.size() / 2], times[0], mib * 1000.0 / times[times.size() / 2]);
+}
+
+template<class Backing>
+void bench(const char* name, int runs) {
+    report(name, "push", &push_run<Backing>, runs);
+    report(name, "pop", &pop_run<Backing>, runs);
+    report(name, "dfs", &dfs_run<Backing>, runs);
+}
+
+int main(int argc, char** argv) {
+    int runs = (argc > 1) ? std::atoi(argv[1]) : 3;
+    long budget_mib = (argc > 2) ? std::atol(argv[2]) : 16;
+    if (runs < 1 || budget_mib < 1) {
+        std::fprintf(stderr, "usage: %s [runs] [budget MiB]\n", argv[0]);
+        return 2;
+    }
+    budget_bytes = size_t(budget_mib) << 20;
+    std::printf("budget %ld MiB, stack %zu states (%zu MiB)\n",
+                budget_mib, state_count(), state_count() * sizeof(uint64_t) >> 20);
+    {
+        Spill full(budget_bytes, block_bytes);
+        for (size_t i = 0; i < state_count(); i++) {
+            full.push_front(uint64_t(i));
+        }
+        std::printf("full stack: %zu MiB in memory, %zu blocks of %zu KiB in the file\n",
+                    full.memory_bytes() >> 20, full.spilled_blocks(), block_bytes >> 10);
+    }
+    bench<Spill>("SpillStorage", runs);
+    bench<SinglyLinkedList<uint64_t>>("SinglyLinkedList", runs);
+    std::printf("checksum %lld\n", (long long)sink);
+    return 0;
+}
@@ -0,0 +1,164 @@
+// file: tiered_bench.cpp
+//
+// Times TieredVector against DoublyLinkedList and std::deque on mixed
+// workloads over a sequence of n ints, n = 100000 unless given:
+//
+//     indexed     90% reads at a random index, 5% inserts and 5% removes at
+//                 random indices
+//     ends        push / pop at either end, 10% reads at a random index
+//     middle      inserts and removes at random indices only
+//
+//     g++ -std=c++17 -O2 tiered_bench.cpp -o tiered_bench
+//     ./tiered_bench [runs] [n]
+//
+// DoublyLinkedList has no operator[]; its reads walk from begin() the way
+// callers did before TieredVector, and insert / remove walk from the front as
+// well. It runs a thousandth of the operations, the times are per operation.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <iterator>
+#include <random>
+#include <vector>
+#include "../LinkedList/DoublyLinkedLis.hpp"
+#include "../LinkedList/TieredVector.hpp"
+
+static size_t n = 100000;                                 // elements at the start of every run, set from argv[2]
+static const size_t op_count = 1000000;                   // operations per run, a thousandth for DoublyLinkedList
+
+static int64_t sink = 0;                                  // keeps the results alive, printed at the end
+
+static double now_ms() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// the operations the workloads need, spelled for each container
+static int get(TieredVector<int>& c, size_t i) { return c[i]; }
+static int get(std::deque<int>& c, size_t i) { return c[i]; }
+static int get(DoublyLinkedList<int>& c, size_t i) { return *std::next(c.begin(), std::ptrdiff_t(i)); }
+
+static void insert_at(TieredVector<int>& c, size_t i, int v) { c.insert(v, i); }
+static void insert_at(std::deque<int>& c, size_t i, int v) { c.insert(c.begin() + std::ptrdiff_t(i), v); }
+static void insert_at(DoublyLinkedList<int>& c, size_t i, int v) { c.insert(v, i); }
+
+static void remove_at(TieredVector<int>& c, size_t i) { c.remove(i); }
+static void remove_at(std::deque<int>& c, size_t i) { c.erase(c.begin() + std::ptrdiff_t(i)); }
+static void remove_at(DoublyLinkedList<int>& c, size_t i) { c.remove(i); }
+
+template<class C>
+size_t ops_for() {
+    return op_count;
+}
+
+template<>
+size_t ops_for<DoublyLinkedList<int>>() {
+    return op_count / 1000;
+}
+
+template<class C>
+void fill(C& c) {
+    for (size_t i = 0; i < n; i++) {
+        c.push_back(int(i));
+    }
+}
+
+// one timed run, returns nanoseconds per operation; filling is not timed
+template<class C>
+double indexed_run() {
+    C c;
+    fill(c);
+    std::mt19937_64 rng(1);
+    size_t ops = ops_for<C>();
+    double start = now_ms();
+    for (size_t k = 0; k < ops; k++) {
+        size_t r = size_t(rng() % 20);
+        if (r == 0) {
+            insert_at(c, size_t(rng() % (c.size() + 1)), int(k));
+        } else if (r == 1 && c.size() > 1) {
+            remove_at(c, size_t(rng() % c.size()));
+        } else {
+            sink += get(c, size_t(rng() % c.size()));
+        }
+    }
+    return (now_ms() - start) * 1e6 / double(ops);
+}
+
+template<class C>
+double ends_run() {
+    C c;
+    fill(c);
+    std::mt19937_64 rng(2);
+    size_t ops = ops_for<C>();
+    double start = now_ms();
+    for (size_t k = 0; k < ops; k++) {
+        size_t r = size_t(rng() % 10);
+        if (r < 2) {
+            c.push_front(int(k));
+        } else if (r < 4) {
+            c.push_back(int(k));
+        } else if (r < 6 && c.size() > 1) {
+            c.pop_front();
+        } else if (r < 8 && c.size() > 1) {
+            c.pop_back();
+        } else if (r == 8) {
+            sink += c.front() + c.back();
+        } else {
+            sink += get(c, size_t(rng() % c.size()));
+        }
+    }
+    return (now_ms() - start) * 1e6 / double(ops);
+}
+
+template<class C>
+double middle_run() {
+    C c;
+    fill(c);
+    std::mt19937_64 rng(3);
+    size_t ops = ops_for<C>();
+    double start = now_ms();
+    for (size_t k = 0; k < ops; k++) {
+        if ((rng() & 1) != 0 || c.size() < 2) {
+            insert_at(c, size_t(rng() % (c.size() + 1)), int(k));
+        } else {
+            remove_at(c, size_t(rng() % c.size()));
+        }
+    }
+    sink += int64_t(c.size());
+    return (now_ms() - start) * 1e6 / double(ops);
+}
+
+static void report(const char* name, const char* workload, double (*run)(), int runs) {
+    std::vector<double> times;
+    for (int r = 0; r < runs; r++) {
+        times.push_back(run());
+    }
+    std::sort(times.begin(), times.end());
+    std::printf("%-20s %-8s median %10.1f ns / op   min %10.1f ns / op\n", name, workload, times[times.size() / 2], times[0]);
+}
+
+template<class C>
+void bench(const char* name, int runs) {
+    report(name, "indexed", &indexed_run<C>, runs);
+    report(name, "ends", &ends_run<C>, runs);
+    report(name, "middle", &middle_run<C>, runs);
+}
+
+int main(int argc, char** argv) {
+    int runs = (argc > 1) ? std::atoi(argv[1]) : 5;
+    long size = (argc > 2) ? std::atol(argv[2]) : 100000;
+    if (runs < 1 || size < 1) {
+        std::fprintf(stderr, "usage: %s [runs] [n]\n", argv[0]);
+        return 2;
+    }
+    n = size_t(size);
+    bench<TieredVector<int>>("TieredVector", runs);
+    bench<std::deque<int>>("std::deque", runs);
+    bench<DoublyLinkedList<int>>("DoublyLinkedList", runs);
+    std::printf("checksum %lld\n", (long long)sink);
+    return 0;
+}
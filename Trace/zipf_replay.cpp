@@ -0,0 +1,122 @@
+// file: zipf_replay.cpp
+//
+// Replays a Zipfian find() trace against SinglyLinkedList and
+// DoublyLinkedList with every SelfOrganize policy and prints the average
+// search depth of each, along with the replay throughput and latency:
+//
+//     g++ -std=c++17 -O2 zipf_replay.cpp -o zipf_replay
+//     ./zipf_replay [finds] [exponent] [trace-out]
+//
+// The trace pushes 10000 keys to the back in random order, so the hot keys
+// start at random depths, then runs the finds (200000 by default) over keys
+// drawn with P(rank k) proportional to 1 / k^exponent, 1.2 by default, where
+// the top 5% of the keys take about 85% of the finds. With a trace-out path
+// the trace is also written there, for replay.cpp.
+//
+// The depth of a find() is the index it returns plus one, the number of
+// nodes it looked at; find() returns the index the value had before the
+// policy moved it.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+#include "TraceReplay.hpp"
+#include "../LinkedList/DoublyLinkedLis.hpp"
+#include "../LinkedList/SinglyLinkedList.hpp"
+
+static const size_t key_count = 10000;
+
+static std::vector<trace_record> zipf_trace(size_t finds, double exponent) {
+    std::mt19937_64 rng(1);
+    std::vector<int64_t> keys(key_count);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), rng);          // the list order
+    std::vector<trace_record> trace;
+    trace.reserve(key_count + finds);
+    for (int64_t key : keys) {
+        trace.push_back(trace_record{op_push_back, key, 0});
+    }
+
+    std::shuffle(keys.begin(), keys.end(), rng);          // keys[k] has rank k + 1, unrelated to its position
+    std::vector<double> cdf(key_count);
+    double total = 0;
+    for (size_t k = 0; k < key_count; k++) {
+        total += 1.0 / std::pow(double(k + 1), exponent);
+        cdf[k] = total;
+    }
+    std::uniform_real_distribution<double> uniform(0.0, total);
+    for (size_t i = 0; i < finds; i++) {
+        size_t k = size_t(std::lower_bound(cdf.begin(), cdf.end(), uniform(rng)) - cdf.begin());
+        trace.push_back(trace_record{op_find, keys[std::min(k, key_count - 1)], 0});
+    }
+    return trace;
+}
+
+// average nodes looked at per find() over one replay
+template<class C>
+double average_depth(const std::vector<trace_record>& trace) {
+    C c;
+    double depth = 0;
+    size_t finds = 0;
+    for (const trace_record& r : trace) {
+        uint64_t result = replay_adapter<C>::apply(c, r);
+        if (r.op == op_find) {
+            depth += double(result) + 1;
+            finds++;
+        }
+    }
+    return (finds == 0) ? 0 : depth / double(finds);
+}
+
+template<class C>
+void run(const char* name, const std::vector<trace_record>& trace) {
+    double depth = average_depth<C>(trace);
+    replay_report r = replay<C>(name, trace);
+    std::cout << std::left << std::setw(32) << name << std::right << std::fixed
+              << std::setprecision(1) << std::setw(12) << depth
+              << std::setprecision(2) << std::setw(12) << ((r.seconds > 0) ? r.ops / r.seconds / 1e6 : 0.0)
+              << std::setprecision(0) << std::setw(10) << r.p50 << std::setw(10) << r.p99 << std::endl;
+}
+
+int main(int argc, char** argv) {
+    long finds = (argc > 1) ? std::atol(argv[1]) : 200000;
+    double exponent = (argc > 2) ? std::atof(argv[2]) : 1.2;
+    if (finds < 1 || exponent <= 0 || argc > 4) {
+        std::cerr << "usage: " << argv[0] << " [finds] [exponent] [trace-out]" << std::endl;
+        return 2;
+    }
+    try {
+        std::vector<trace_record> trace = zipf_trace(size_t(finds), exponent);
+        if (argc > 3) {
+            TraceWriter out(argv[3]);
+            for (const trace_record& r : trace) {
+                out.record(r.op, r.value, r.index);
+            }
+        }
+        std::cout << key_count << " keys, " << finds << " finds, exponent " << exponent << std::endl;
+        std::cout << std::left << std::setw(32) << "list" << std::right
+                  << std::setw(12) << "avg depth" << std::setw(12) << "Mops/s"
+                  << std::setw(10) << "p50 ns" << std::setw(10) << "p99 ns" << std::endl;
+        run<SinglyLinkedList<int64_t, static_order>>("Singly, static_order", trace);
+        run<SinglyLinkedList<int64_t, move_to_front_order>>("Singly, move_to_front_order", trace);
+        run<SinglyLinkedList<int64_t, transpose_order>>("Singly, transpose_order", trace);
+        run<SinglyLinkedList<int64_t, count_order>>("Singly, count_order", trace);
+        run<DoublyLinkedList<int64_t, static_order>>("Doubly, static_order", trace);
+        run<DoublyLinkedList<int64_t, move_to_front_order>>("Doubly, move_to_front_order", trace);
+        run<DoublyLinkedList<int64_t, transpose_order>>("Doubly, transpose_order", trace);
+        run<DoublyLinkedList<int64_t, count_order>>("Doubly, count_order", trace);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,261 @@
+// file: TaskScheduler.hpp
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "WorkStealingDeque.hpp"
+
+class TaskGroup;
+
+// Work-stealing task scheduler.
+// Every worker thread owns a WorkStealingDeque; tasks spawned from a worker go
+// to the bottom of its own deque, idle workers steal from the top of others.
+// Tasks submitted from a non-worker thread go through a small shared queue.
+class TaskScheduler {
+    private:
+        struct Task {
+            std::function<void()> fn;
+            TaskGroup* group;
+        };
+
+        struct alignas(64) Worker {
+            WorkStealingDeque<Task*> deque;
+            std::thread thread;
+        };
+
+        std::vector<std::unique_ptr<Worker>> workers_;
+        std::deque<Task*> injected_;                      // tasks from non-worker threads
+        std::mutex injected_mutex_;
+
+        std::atomic<size_t> queued_;                      // tasks pushed but not yet taken
+        std::atomic<size_t> sleepers_;
+        std::atomic<bool> stop_;
+        std::mutex sleep_mutex_;
+        std::condition_variable sleep_cv_;
+
+        static size_t& current_index();                   // worker index of the calling thread, npos if none
+        static TaskScheduler*& current_scheduler();
+
+        void spawn(Task*);
+        bool run_one();                                   // try to run one task, false if none was found
+        void execute(Task*);
+        void worker_loop(size_t);
+
+        friend class TaskGroup;
+
+    public:
+        static const size_t npos = -1;
+
+        explicit TaskScheduler(size_t num_threads = std::thread::hardware_concurrency());
+        ~TaskScheduler();                                 // runs every queued task, then joins the workers
+
+        TaskScheduler(const TaskScheduler&) = delete;
+        TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+        void submit(std::function<void()>);               // fire-and-forget task
+        size_t num_workers() const;
+};
+
+// Fork-join handle: run() spawns child tasks, wait() blocks until all of them
+// finished, executing pending tasks meanwhile instead of sleeping.
+// The first exception thrown by a child is rethrown from wait().
+class TaskGroup {
+    private:
+        TaskScheduler& scheduler_;
+        std::atomic<size_t> pending_;
+        std::exception_ptr error_;
+        std::mutex error_mutex_;
+
+        friend class TaskScheduler;
+
+    public:
+        explicit TaskGroup(TaskScheduler&);
+        ~TaskGroup();
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        void run(std::function<void()>);
+        void wait();
+};
+
+inline size_t& TaskScheduler::current_index() {
+    thread_local size_t index = npos;
+    return index;
+}
+
+inline TaskScheduler*& TaskScheduler::current_scheduler() {
+    thread_local TaskScheduler* scheduler = nullptr;
+    return scheduler;
+}
+
+inline TaskScheduler::TaskScheduler(size_t num_threads) {
+    if (num_threads == 0) {
+        num_threads = 1;
+    }
+    queued_.store(0);
+    sleepers_.store(0);
+    stop_.store(false);
+
+    for (size_t i = 0; i < num_threads; i++) {
+        workers_.push_back(std::unique_ptr<Worker>(new Worker()));
+    }
+    for (size_t i = 0; i < num_threads; i++) {
+        workers_[i]->thread = std::thread(&TaskScheduler::worker_loop, this, i);
+    }
+}
+
+inline TaskScheduler::~TaskScheduler() {
+    stop_.store(true);
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        sleep_cv_.notify_all();
+    }
+    for (auto& worker : workers_) {
+        worker->thread.join();
+    }
+}
+
+inline void TaskScheduler::submit(std::function<void()> fn) {
+    spawn(new Task{std::move(fn), nullptr});
+}
+
+inline size_t TaskScheduler::num_workers() const {
+    return workers_.size();
+}
+
+inline void TaskScheduler::spawn(Task* task) {
+    queued_.fetch_add(1, std::memory_order_release);
+    if (current_scheduler() == this) {
+        workers_[current_index()]->deque.push(task);
+    } else {
+        std::lock_guard<std::mutex> lock(injected_mutex_);
+        injected_.push_back(task);
+    }
+    if (sleepers_.load(std::memory_order_acquire) > 0) {
+        sleep_cv_.notify_one();
+    }
+}
+
+inline bool TaskScheduler::run_one() {
+    Task* task = nullptr;
+    size_t self = (current_scheduler() == this) ? current_index() : npos;
+
+    if (self != npos && workers_[self]->deque.pop(task)) {
+        execute(task);
+        return true;
+    }
+
+    // pick victims starting at a per-thread pseudo random offset
+    thread_local uint32_t seed = static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1u;
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    size_t n = workers_.size();
+    size_t start = seed % n;
+    for (size_t i = 0; i < n; i++) {
+        size_t victim = (start + i) % n;
+        if (victim != self && workers_[victim]->deque.steal(task)) {
+            execute(task);
+            return true;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(injected_mutex_);
+        if (!injected_.empty()) {
+            task = injected_.front();
+            injected_.pop_front();
+        }
+    }
+    if (task != nullptr) {
+        execute(task);
+        return true;
+    }
+    return false;
+}
+
+inline void TaskScheduler::execute(Task* task) {
+    queued_.fetch_sub(1, std::memory_order_acq_rel);
+    TaskGroup* group = task->group;
+    try {
+        task->fn();
+    } catch (...) {
+        if (group != nullptr) {
+            std::lock_guard<std::mutex> lock(group->error_mutex_);
+            if (!group->error_) {
+                group->error_ = std::current_exception();
+            }
+        }
+    }
+    delete task;
+    if (group != nullptr) {
+        group->pending_.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+inline void TaskScheduler::worker_loop(size_t index) {
+    current_scheduler() = this;
+    current_index() = index;
+
+    while (true) {
+        if (run_one()) {
+            continue;
+        }
+        if (stop_.load(std::memory_order_acquire) && queued_.load(std::memory_order_acquire) == 0) {
+            break;
+        }
+        // the timeout covers a spawn racing with going to sleep
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        sleepers_.fetch_add(1, std::memory_order_acq_rel);
+        sleep_cv_.wait_for(lock, std::chrono::milliseconds(1), [this] {
+            return stop_.load(std::memory_order_acquire) || queued_.load(std::memory_order_acquire) > 0;
+        });
+        sleepers_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    current_scheduler() = nullptr;
+    current_index() = npos;
+}
+
+inline TaskGroup::TaskGroup(TaskScheduler& scheduler) : scheduler_(scheduler) {
+    pending_.store(0);
+}
+
+inline TaskGroup::~TaskGroup() {
+    // never leave children pointing at a dead group
+    while (pending_.load(std::memory_order_acquire) != 0) {
+        if (!scheduler_.run_one()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+inline void TaskGroup::run(std::function<void()> fn) {
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    scheduler_.spawn(new TaskScheduler::Task{std::move(fn), this});
+}
+
+inline void TaskGroup::wait() {
+    while (pending_.load(std::memory_order_acquire) != 0) {
+        if (!scheduler_.run_one()) {
+            std::this_thread::yield();
+        }
+    }
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    if (error_) {
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
@@ -0,0 +1,155 @@
+// file: WorkStealingDeque.hpp
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Chase-Lev work-stealing deque.
+// The owner thread calls push() / pop() at the bottom without locking, any
+// other thread may call steal() at the top, which races through a single CAS.
+// The storage is a power-of-two circular array that doubles when full; old
+// arrays are kept until destruction because a thief may still be reading one.
+// T must be trivially copyable (usually a pointer to a task).
+template<class T>
+class WorkStealingDeque {
+    private:
+        class CircularArray {
+            private:
+                size_t capacity_;
+                size_t mask_;
+                std::atomic<T>* buffer_;
+            public:
+                explicit CircularArray(size_t capacity)
+                    : capacity_(capacity), mask_(capacity - 1), buffer_(new std::atomic<T>[capacity]) {};
+                ~CircularArray() { delete[] buffer_; };
+
+                size_t capacity() const { return capacity_; };
+                T get(int64_t i) const { return buffer_[i & mask_].load(std::memory_order_relaxed); };
+                void put(int64_t i, T val) { buffer_[i & mask_].store(val, std::memory_order_relaxed); };
+
+                CircularArray* grow(int64_t bottom, int64_t top) const {
+                    CircularArray* bigger = new CircularArray(capacity_ * 2);
+                    for (int64_t i = top; i != bottom; i++) {
+                        bigger->put(i, get(i));
+                    }
+                    return bigger;
+                };
+        };
+
+        alignas(64) std::atomic<int64_t> top_;
+        alignas(64) std::atomic<int64_t> bottom_;
+        std::atomic<CircularArray*> array_;
+        std::vector<CircularArray*> retired_;             // arrays replaced by grow(), owned by the owner thread
+
+    public:
+        explicit WorkStealingDeque(size_t capacity = 1024);  // capacity is rounded up to a power of two
+        ~WorkStealingDeque();
+
+        WorkStealingDeque(const WorkStealingDeque&) = delete;
+        WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+        void push(T);                                     // owner only: push element to the bottom
+        bool pop(T&);                                     // owner only: pop element from the bottom, false if empty
+        bool steal(T&);                                   // any thread: take element from the top, false if empty or lost the race
+
+        size_t size() const;                              // approximate number of elements
+        bool empty() const;                               // approximate emptiness check
+        size_t capacity() const;                          // capacity of the current array
+};
+
+template<class T>
+WorkStealingDeque<T>::WorkStealingDeque(size_t capacity) {
+    size_t cap = 2;
+    while (cap < capacity) {
+        cap <<= 1;
+    }
+    top_.store(0, std::memory_order_relaxed);
+    bottom_.store(0, std::memory_order_relaxed);
+    array_.store(new CircularArray(cap), std::memory_order_relaxed);
+}
+
+template<class T>
+WorkStealingDeque<T>::~WorkStealingDeque() {
+    for (CircularArray* old : retired_) {
+        delete old;
+    }
+    delete array_.load(std::memory_order_relaxed);
+}
+
+template<class T>
+void WorkStealingDeque<T>::push(T val) {
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t t = top_.load(std::memory_order_acquire);
+    CircularArray* a = array_.load(std::memory_order_relaxed);
+    if (b - t > static_cast<int64_t>(a->capacity()) - 1) {
+        CircularArray* bigger = a->grow(b, t);
+        retired_.push_back(a);
+        array_.store(bigger, std::memory_order_release);
+        a = bigger;
+    }
+    a->put(b, val);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+}
+
+template<class T>
+bool WorkStealingDeque<T>::pop(T& val) {
+    int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    CircularArray* a = array_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top_.load(std::memory_order_relaxed);
+
+    if (t > b) {
+        // deque was empty
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    val = a->get(b);
+    if (t == b) {
+        // last element, race against thieves for it
+        bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return won;
+    }
+    return true;
+}
+
+template<class T>
+bool WorkStealingDeque<T>::steal(T& val) {
+    int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom_.load(std::memory_order_acquire);
+
+    if (t < b) {
+        CircularArray* a = array_.load(std::memory_order_acquire);
+        T stolen = a->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return false;
+        }
+        val = stolen;
+        return true;
+    }
+    return false;
+}
+
+template<class T>
+size_t WorkStealingDeque<T>::size() const {
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t t = top_.load(std::memory_order_relaxed);
+    return (b > t) ? static_cast<size_t>(b - t) : 0;
+}
+
+template<class T>
+bool WorkStealingDeque<T>::empty() const {
+    return size() == 0;
+}
+
+template<class T>
+size_t WorkStealingDeque<T>::capacity() const {
+    return array_.load(std::memory_order_relaxed)->capacity();
+}